@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <string.h>
 #include "pico/stdlib.h"
 #include "pico/binary_info.h"
 #include "pico/multicore.h"
@@ -10,6 +11,16 @@
 #include "hardware/clocks.h"
 #include "hardware/structs/pll.h"
 #include "hardware/structs/clocks.h"
+#include "hardware/structs/systick.h"
+#include "hardware/structs/xip_ctrl.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/interp.h"
+#include "hardware/divider.h"
+#include "hardware/structs/io_bank0.h"
+#include "hardware/flash.h"
+#include "pico/flash.h"
 
 // Pico W devices use a GPIO on the WIFI chip for the LED,
 // so when building for Pico W, CYW43_WL_GPIO_LED_PIN will be defined.
@@ -22,20 +33,35 @@
 
 typedef char * string;
 
-#ifdef CYW43_WL_GPIO_LED_PIN
-    bool is_pico_w = true;
-#elif defined(PICO_DEFAULT_LED_PIN)
-    bool is_pico_w = false;
+// Defined in src/init.c
+#if defined(CYW43_WL_GPIO_LED_PIN) || defined(PICO_DEFAULT_LED_PIN)
+    extern bool is_pico_w;
 #endif
 
-bool is_led_init = false;
-bool is_adc_init = false;
-bool is_gpio_init = false;
-bool is_pico_w_init = false;
+extern bool is_led_init;
+extern bool is_adc_init;
+extern bool is_gpio_init;
+extern bool is_pico_w_init;
+
+extern uint8_t temp_used_adc_gpio_pins[9];
+extern uint8_t * used_adc_gpio_pins;
+extern uint8_t temp_adc_gpio_index;
+extern uint8_t adc_input_init_mask;
 
-uint8_t temp_used_adc_gpio_pins[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
-uint8_t * used_adc_gpio_pins = temp_used_adc_gpio_pins;
-uint8_t temp_adc_gpio_index = 0;
+// Building with PICO_LIBRARY_INLINE defined (see the CMake option of the same name)
+// turns the wrappers marked PICO_LIBRARY_FAST into static inline functions in this
+// header and drops their lazy initialisation checks. Set-up then has to be done up
+// front with the *_init functions, after which gpio_pin_set_high_low compiles down
+// to a single SIO store.
+#ifdef PICO_LIBRARY_INLINE
+    #define PICO_LIBRARY_FAST static inline
+#else
+    #define PICO_LIBRARY_FAST
+#endif
+
+// Hot path placement, PICO_LIBRARY_HOT, and what the subsystems that also build on a host
+// take from the SDK.
+#include "src/portable.h"
 
 enum temperature_enum
 {
@@ -44,30 +70,539 @@ enum temperature_enum
     KELVIN
 };
 
-int main();
+// Initialisation functions
+void led_init();
+void adc_library_init();
+void adc_input_init(uint8_t adc_input);
+void gpio_pin_init(uint8_t pin);
 
 // Basic functions
-void sleep(uint32_t milliseconds);
-void led_set(bool led_on);
+PICO_LIBRARY_FAST void sleep(uint32_t milliseconds);
+PICO_LIBRARY_FAST void PICO_LIBRARY_HOT(led_set)(bool led_on);
 
 // ADC functions
-uint16_t adc_read_gpio_pin_raw(uint8_t adc_input);
-float adc_read_gpio_pin_volts(uint8_t adc_input);
-void adc_set_temperature_sensor(bool on);
-void adc_select_pin(uint8_t pin);
-uint16_t adc_read_selected_raw();
-float adc_read_selected_volts();
-void __not_in_flash_func(adc_capture)(uint16_t *buf, size_t count);
+// 12-bit conversion, assume max value == ADC_VREF == 3.3 V
+#define ADC_VOLTS_PER_CODE (3.3f / (1 << 12))
+
+PICO_LIBRARY_FAST uint16_t PICO_LIBRARY_HOT(adc_read_gpio_pin_raw)(uint8_t adc_input);
+PICO_LIBRARY_FAST float PICO_LIBRARY_HOT(adc_read_gpio_pin_volts)(uint8_t adc_input);
+PICO_LIBRARY_FAST void adc_set_temperature_sensor(bool on);
+PICO_LIBRARY_FAST void PICO_LIBRARY_HOT(adc_select_pin)(uint8_t pin);
+PICO_LIBRARY_FAST uint16_t PICO_LIBRARY_HOT(adc_read_selected_raw)();
+PICO_LIBRARY_FAST float PICO_LIBRARY_HOT(adc_read_selected_volts)();
+void PICO_LIBRARY_HOT(adc_capture)(uint16_t *buf, size_t count);
+void PICO_LIBRARY_HOT(adc_capture_packed)(void * packed, size_t count);
 float acd_read_onboard_temperature(enum temperature_enum temperature, uint8_t pin);
 
+// ADC oversampling functions
+// The kernels are in src/adc_oversample.h. adc_oversample_read_block runs them on raw
+// blocks from two chained DMA channels, decimating one while the other fills. If it falls
+// a whole block behind, for example with interrupts held up for that long, it stops and
+// returns PICO_ERROR_IO with what it had read so far in output.
+#include "src/adc_oversample.h"
+
+int adc_oversample_read_block(uint8_t adc_input, uint8_t bits, uint32_t sample_rate, uint16_t * output, size_t count);
+
+// ADC trigger functions
+// Oscilloscope style capture. A DMA channel writes samples into a ring without stopping
+// and adc_trigger_wait scans the ring a block at a time, so samples from before the trigger
+// are still there when it fires. After a capture the trigger re-arms on its own once the
+// window and the holdoff time from the trigger point have both passed. Level modes fire as
+// soon as the signal is past the level. Edge and window modes have to see it cross, after
+// going back by the hysteresis past the level, or outside or inside the window. Uses the
+// ADC and a DMA channel, like audio_start and usb_stream_start. The ring stays a static
+// array rather than sample pool blocks, as the hardware wrap needs it aligned to its whole
+// 16 KB.
+#define ADC_TRIGGER_RING_BITS 14 // 16 KB ring of 16-bit samples
+#define ADC_TRIGGER_RING_SAMPLES ((1 << ADC_TRIGGER_RING_BITS) / 2)
+#define ADC_TRIGGER_BLOCK 256
+#define ADC_TRIGGER_MAX_WINDOW (ADC_TRIGGER_RING_SAMPLES / 2) // Leaves half the ring to copy the window out
+
+enum adc_trigger_mode_enum
+{
+    ADC_TRIGGER_ABOVE,          // Level
+    ADC_TRIGGER_BELOW,
+    ADC_TRIGGER_RISING,         // Edge
+    ADC_TRIGGER_FALLING,
+    ADC_TRIGGER_ENTER_WINDOW,   // level to level_high
+    ADC_TRIGGER_LEAVE_WINDOW
+};
+
+typedef struct
+{
+    enum adc_trigger_mode_enum mode;
+    uint16_t level;
+    uint16_t level_high;        // Window modes only
+    uint16_t hysteresis;
+    uint32_t pre_samples;
+    uint32_t post_samples;      // Including the trigger sample
+    uint32_t holdoff_us;
+} adc_trigger_config_t;
+
+typedef struct
+{
+    uint32_t sample_rate;
+    uint32_t triggers;
+    uint32_t blocks_scanned;
+    uint32_t overruns;          // Times the ring was overwritten before it was scanned or copied
+    uint32_t trigger_position;  // Sample count since adc_trigger_start of the last trigger
+} adc_trigger_stats_t;
+
+int adc_trigger_start(uint8_t adc_input, uint32_t sample_rate, const adc_trigger_config_t * config);
+int adc_trigger_wait(uint16_t * buffer, uint32_t timeout_us);
+void adc_trigger_stop();
+void adc_trigger_get_stats(adc_trigger_stats_t * stats);
+
+// Timing functions
+void cycle_counter_start();
+uint32_t PICO_LIBRARY_HOT(cycle_counter_get)();
+uint32_t PICO_LIBRARY_HOT(cycle_counter_elapsed)(uint32_t start);
+
+typedef struct
+{
+    uint32_t hits;
+    uint32_t accesses;
+} xip_cache_stats_t;
+
+void xip_cache_stats_reset();
+void xip_cache_stats_get(xip_cache_stats_t * stats);
+
+// Block pool functions
+// Buffer memory shared between capture, processing and sending instead of a static array
+// for each. An arena hands out memory from one region in order and is only reset whole,
+// pools carve fixed-size blocks from an arena at start-up. Blocks are aligned for DMA, to
+// their size rounded up to a power of two if they are used as DMA rings, and reference
+// counted, so a stage passes a block on by retaining it for the next one, and the last
+// release returns it. Pools take a spin lock, so any core or interrupt can use them, but
+// arenas are not locked. Main SRAM is striped over four banks, so DMA and both cores rarely
+// wait on each other there. The 4 KB scratch banks give a stream a bank of its own, but
+// they also hold the core stacks.
+#define BLOCK_POOL_MIN_ALIGN 4
+#define BLOCK_POOL_MAX_REFS UINT8_MAX // A block retained this often is kept for good
+
+#define BLOCK_ARENA_MEMORY(name, size) uint8_t __uninitialized_ram(name)[size] __aligned(BLOCK_POOL_MIN_ALIGN)
+#define BLOCK_ARENA_MEMORY_SCRATCH_X(name, size) uint8_t __scratch_x(#name) name[size] __aligned(BLOCK_POOL_MIN_ALIGN)
+#define BLOCK_ARENA_MEMORY_SCRATCH_Y(name, size) uint8_t __scratch_y(#name) name[size] __aligned(BLOCK_POOL_MIN_ALIGN)
+
+typedef struct
+{
+    uint8_t * memory;
+    size_t size;
+    size_t used;
+    size_t high_water;
+    uint32_t failures;
+} block_arena_t;
+
+typedef struct
+{
+    uint8_t * blocks;
+    uint8_t * refs;             // A count for each block, 0 when free
+    void * free_list;           // Linked through the first word of each free block
+    size_t stride;
+    size_t block_size;
+    uint16_t block_count;
+    uint16_t in_use;
+    uint16_t high_water;
+    uint32_t failures;
+    spin_lock_t * lock;
+} block_pool_t;
+
+typedef struct
+{
+    size_t block_size;
+    uint16_t block_count;
+    uint16_t in_use;
+    uint16_t high_water;        // Most blocks in use at once
+    uint32_t failures;          // Allocations with none free
+} block_pool_stats_t;
+
+void block_arena_init(block_arena_t * arena, void * memory, size_t size);
+void * block_arena_alloc(block_arena_t * arena, size_t size, size_t align);
+void block_arena_reset(block_arena_t * arena);
+int block_pool_init(block_pool_t * pool, block_arena_t * arena, size_t block_size, uint16_t block_count, size_t align);
+void * PICO_LIBRARY_HOT(block_pool_alloc)(block_pool_t * pool);
+void PICO_LIBRARY_HOT(block_pool_retain)(block_pool_t * pool, void * block);
+void PICO_LIBRARY_HOT(block_pool_release)(block_pool_t * pool, void * block);
+uint8_t block_pool_refs(block_pool_t * pool, void * block);
+void block_pool_get_stats(block_pool_t * pool, block_pool_stats_t * stats);
+
+// The library's own sample buffers come from one shared pool of SAMPLE_POOL_BLOCK_SIZE
+// blocks, set up on first use. usb_stream_start holds USB_STREAM_BLOCKS blocks until
+// usb_stream_stop, audio_start and audio_out_start one each until their stops, and
+// adc_oversample_read_block and RPC_ADC_READ_BULK one while they run. All but audio output
+// use the ADC, so at most one of them is held together with audio output, which the
+// default count covers. Starting with the pool empty returns PICO_ERROR_INSUFFICIENT_RESOURCES.
+// The adc_trigger ring is not taken from it, see adc_trigger_start.
+#define SAMPLE_POOL_BLOCK_SIZE 4096
+#ifndef SAMPLE_POOL_BLOCKS
+    #define SAMPLE_POOL_BLOCKS (USB_STREAM_BLOCKS + 1)
+#endif
+
+block_pool_t * sample_pool_get();
+
+// Audio functions
+// Samples are Q15, blocks are filtered in place. audio_start streams an ADC input
+// through DMA and runs convert, DC removal, decimating FIR and levels on core1. Its DMA
+// interrupt is DMA_IRQ_0, enabled on core1 only. The other DMA users in the library share
+// DMA_IRQ_1, so they have to be started from one core, core0 when audio_start is used.
+// The two buffers are halves of a sample pool block. audio_start returns
+// PICO_ERROR_NOT_PERMITTED while audio is running, and PICO_ERROR_INSUFFICIENT_RESOURCES
+// with the pool empty. audio_stop resets core1 and releases the channels and the block,
+// core1 is then free for another user.
+#define AUDIO_BLOCK_SIZE 256
+#define AUDIO_FIR_TAPS 32
+#define AUDIO_MAX_DECIMATION 8
+#define AUDIO_DC_POLE 32604 // 0.995 in Q15, about 25 Hz corner at 32 kHz
+#define AUDIO_SILENCE_DB -120.0f
+
+typedef struct
+{
+    int32_t previous_input;
+    int32_t previous_output;
+    int32_t pole;
+} audio_dc_filter_t;
+
+typedef struct
+{
+    int16_t coefficients[AUDIO_FIR_TAPS];
+    int16_t history[AUDIO_FIR_TAPS * 2];
+    uint8_t index;
+    uint8_t phase;
+    uint8_t decimation;
+} audio_fir_t;
+
+typedef struct
+{
+    uint32_t block_count;
+    uint32_t dropped_blocks;
+    uint32_t sample_rate;
+    uint32_t output_count;
+    uint16_t rms;
+    uint16_t peak;
+    float level_db;
+    uint32_t convert_cycles;
+    uint32_t dc_cycles;
+    uint32_t fir_cycles;
+    uint32_t measure_cycles;
+} audio_stats_t;
+
+void PICO_LIBRARY_HOT(audio_convert_block)(int16_t * samples, size_t count);
+void audio_dc_filter_init(audio_dc_filter_t * filter);
+void PICO_LIBRARY_HOT(audio_dc_remove_block)(audio_dc_filter_t * filter, int16_t * samples, size_t count);
+void audio_fir_init(audio_fir_t * fir, uint8_t decimation);
+size_t PICO_LIBRARY_HOT(audio_fir_decimate_block)(audio_fir_t * fir, int16_t * samples, size_t count);
+void PICO_LIBRARY_HOT(audio_measure_block)(const int16_t * samples, size_t count, audio_stats_t * stats);
+int audio_start(uint8_t adc_input, uint32_t sample_rate, uint8_t decimation, void (*block_callback)(int16_t * samples, size_t count, const audio_stats_t * stats));
+void audio_stop();
+bool audio_get_stats(audio_stats_t * stats);
+
+// Audio output functions
+// Playback through PWM and an RC low pass filter. Two chained DMA channels take turns
+// feeding blocks of levels to the slice's compare register, paced by a DMA timer at the
+// sample rate, while the PWM runs much faster than that so the filter removes it. As each
+// block finishes, its interrupt renders the next one from the source. Rendering resamples
+// by linear interpolation with a Q16.16 step and applies a Q15 volume. Sources are Q15
+// samples, or raw 12-bit ADC samples such as from adc_capture, which are converted on the
+// way. Playing no samples goes quiet. Both pins of the slice play the same output. Uses
+// DMA_IRQ_1, like usb_stream_start.
+#define AUDIO_OUT_BLOCK_SIZE 256
+#define AUDIO_OUT_PWM_WRAP 1023 // 10-bit levels, 122 kHz PWM at 125 MHz
+#define AUDIO_OUT_VOLUME_MAX 32767
+
+typedef struct
+{
+    uint32_t sample_rate;       // What the DMA timer actually runs at
+    uint32_t blocks;
+    uint32_t render_us;         // For the last block
+} audio_out_stats_t;
+
+int audio_out_start(uint8_t pin, uint32_t sample_rate);
+void audio_out_play(const int16_t * samples, size_t count, uint32_t source_rate, bool is_looping);
+void audio_out_play_adc(const uint16_t * samples, size_t count, uint32_t source_rate, bool is_looping);
+void audio_out_set_volume(uint16_t volume);
+bool audio_out_is_playing();
+void audio_out_stop();
+void audio_out_get_stats(audio_out_stats_t * stats);
+void audio_out_fill_sine(int16_t * samples, size_t count, uint32_t cycles, int16_t amplitude);
+
+// FFT job functions
+// The transform is in src/fft.h. fft_core1_start runs jobs on core1, a job at a time in
+// the order they were submitted. One job can wait while another runs, fft_core1_submit
+// blocks until the waiting one has been taken. Jobs are submitted from core0 only.
+#include "src/fft.h"
+
+typedef struct
+{
+    fft_complex_t * data;
+    uint16_t * magnitude;
+    size_t points;
+    size_t peak_bin;
+    uint32_t cycles;
+    volatile bool is_busy;
+} fft_job_t;
+
+void fft_run_job(fft_job_t * job);
+void fft_core1_start();
+void fft_core1_submit(fft_job_t * job);
+void fft_core1_wait(fft_job_t * job);
+
+// Conversion functions
+// Batch kernels on this core's interpolators, so not safe to call from interrupts that
+// also use them. Tables are indexed by the 12-bit ADC code. convert_scale_factor gives the
+// Q16 ratio numerator / denominator, saturated at UINT32_MAX, which is also what a zero
+// denominator gives. convert_scale_clamp_batch needs raw * scale to fit in 32 bits, a
+// scale below 2^20 for 12-bit samples.
+#define CONVERT_TABLE_SIZE (1 << 12)
+
+void convert_table_millivolts(int16_t * table);
+void convert_table_temperature(int16_t * table);
+uint32_t convert_scale_factor(uint32_t numerator, uint32_t denominator);
+void PICO_LIBRARY_HOT(convert_lookup_batch)(const uint16_t * raw, int16_t * output, size_t count, const int16_t * table);
+void PICO_LIBRARY_HOT(convert_scale_clamp_batch)(const uint16_t * raw, uint16_t * output, size_t count, uint32_t scale, uint16_t minimum, uint16_t maximum);
+
+// Packed sample functions
+// 12-bit samples two to three bytes, in src/pack12.h.
+#include "src/pack12.h"
+
+// Compression functions
+// Lossless blocks of 12-bit samples, in src/rice.h.
+#include "src/rice.h"
+
+// Edge capture functions
+// Rising and falling edges on a set of pins, timestamped in microseconds by the GPIO
+// interrupt and queued in a lock-free ring that edge_capture_process drains. Only one
+// capture runs at a time, edge_capture_start returns PICO_ERROR_NOT_PERMITTED until it is
+// stopped. When both edges of a pin latch before the interrupt runs, edges were missed:
+// edge_capture_missed counts these, and both events are queued with is_missed set and
+// left out of the period, high and low times.
+#define EDGE_BUFFER_SIZE 1024 // Must be a power of two
+
+typedef struct
+{
+    uint64_t timestamp;
+    uint8_t pin;
+    bool is_rising;
+    bool is_missed;
+} edge_event_t;
+
+typedef struct
+{
+    uint64_t last_rise;
+    uint64_t last_fall;
+    uint64_t period_sum_us;
+    uint32_t period_count;
+    uint32_t period_us;
+    uint32_t high_us;
+    uint32_t low_us;
+    uint32_t edge_count;
+} edge_stats_t;
+
+int edge_capture_start(uint32_t pin_mask);
+void edge_capture_stop();
+bool PICO_LIBRARY_HOT(edge_capture_pop)(edge_event_t * event);
+size_t PICO_LIBRARY_HOT(edge_capture_process)();
+void edge_capture_get_stats(uint8_t pin, edge_stats_t * stats);
+float edge_capture_frequency(uint8_t pin);
+float edge_capture_duty_cycle(uint8_t pin);
+uint32_t edge_capture_overruns();
+uint32_t edge_capture_missed();
+
+// Pulse measurement functions
+// High and low times of any pin in clk_sys cycles, from a PIO state machine a pin. Each
+// state machine counts in two-cycle loops and pushes both times every period, and a DMA
+// channel copies them into a table, so reading a result costs no interrupts and no PWM
+// slice. The pin is only read, so a pin driven by a PWM slice or anything else can be
+// measured in place. The high and low times read can come from neighbouring periods.
+// Times saturate at UINT32_MAX cycles. A stopped signal keeps its last times in the table,
+// so a result is stale once pulse_measure_get has seen no new period for twice the last
+// one plus PULSE_MEASURE_STALE_MIN_US, and the frequency is 0 then. Uses DMA_IRQ_1 only to
+// restart the DMA channels after 2^31 periods.
+#define PULSE_MEASURE_MAX_PINS 8 // A state machine each
+#define PULSE_MEASURE_STALE_MIN_US 10000
+
+typedef struct
+{
+    uint32_t high_cycles;
+    uint32_t low_cycles;
+    uint32_t periods;       // Measured so far
+    bool is_stale;          // No new period for twice the last one
+} pulse_measure_result_t;
+
+int pulse_measure_start(uint8_t pin);
+void pulse_measure_stop(uint8_t pin);
+bool PICO_LIBRARY_HOT(pulse_measure_get)(uint8_t pin, pulse_measure_result_t * result);
+float pulse_measure_frequency(uint8_t pin);
+float pulse_measure_duty_cycle(uint8_t pin);
+
+// PWM waveform functions
+// Plays tables of PWM levels on a pin with no CPU time per step. A DMA channel writes the
+// next level into the slice's compare register every time the counter wraps, so the PWM
+// frequency is the step rate. A second channel loads each table of the list in turn, so
+// chained tables play back to back. At the end of the list the first channel raises its
+// interrupt once, which either restarts the list for a loop or stops it. A 16-bit write
+// to the compare register sets both channels of the slice, so the slice's other pin plays
+// the same waveform if it is also set to PWM. Uses DMA_IRQ_1 and two DMA channels a slice.
+#define PWM_WAVE_MAX_SEGMENTS 8
+
+// Laid out as the DMA registers it is copied into: transfer count, then read address.
+typedef struct
+{
+    uint32_t count;
+    const uint16_t * levels;
+} pwm_wave_segment_t;
+
+int pwm_wave_start(uint8_t pin, uint16_t wrap, float step_hz, const pwm_wave_segment_t * segments, uint8_t segment_count, bool is_looping);
+void pwm_wave_stop(uint8_t pin);
+bool pwm_wave_is_running(uint8_t pin);
+void pwm_wave_fill_breathe(uint16_t * levels, size_t count, uint16_t wrap);
+void pwm_wave_fill_blink(uint16_t * levels, size_t count, uint16_t wrap, float duty);
+void pwm_wave_fill_sine(uint16_t * levels, size_t count, uint16_t wrap);
+
+// Debounce functions
+// All pins are sampled together with gpio_get_all on a timer tick. A change is accepted
+// after four equal ticks, and a hold is reported once a pin stays pressed for hold_ticks.
+// A hold_ticks of 0 turns hold reports off.
+#define DEBOUNCE_HOLD_BITS 10 // Longest hold is 2^10 - 1 ticks
+
+typedef struct
+{
+    uint32_t pressed;
+    uint32_t released;
+    uint32_t held;
+} debounce_events_t;
+
+void PICO_LIBRARY_HOT(debounce_tick)(uint32_t sample);
+void debounce_reset(uint32_t pin_mask, uint32_t active_low_mask, uint16_t hold_ticks);
+int debounce_start(uint32_t pin_mask, uint32_t active_low_mask, uint32_t tick_us, uint16_t hold_ticks);
+void debounce_stop();
+uint32_t debounce_get_state();
+void debounce_get_events(debounce_events_t * events);
+
+// Flash log functions
+// The log format is in src/flash_log.h. flash_log_init runs it on the last FLASH_LOG_SIZE
+// bytes of flash, which the program image must not reach. Erase and program run from RAM
+// through flash_safe_execute, with interrupts off and the other core parked.
+#include "src/flash_log.h"
+
+#ifndef FLASH_LOG_SIZE
+    #define FLASH_LOG_SIZE (256 * 1024)
+#endif
+#define FLASH_LOG_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_LOG_SIZE)
+#define FLASH_LOG_TIMEOUT_MS 100
+
+int flash_log_init();
+
+// RPC functions
+// The protocol is in src/rpc.h. rpc_init runs it with the commands of rpc_command_enum over
+// the transport's write function, NULL for stdio (USB CDC), and rpc_serve feeds it from
+// stdio until RPC_EXIT. host/rpc_client.h is the other end.
+#include "src/rpc.h"
+
+void rpc_init(void (*write)(const uint8_t * data, size_t count));
+void rpc_serve();
+
+// USB stream functions
+// ADC samples sent over a vendor-class bulk IN endpoint next to the CDC stdio interface,
+// for rates stdio cannot carry. Only in images that link pico_library_usb_stream. Two
+// chained DMA channels fill a ring of USB_STREAM_BLOCKS blocks, and each full block goes
+// to the host as one transfer, laid out as in src/usb_stream.h. Packed blocks are packed
+// in place as they fill and sent short, a quarter fewer bytes for the same samples.
+// Compressed blocks are encoded the same way, a rice_encode_block block after the header,
+// so their length varies. Both are encoded on core1, which usb_stream_start launches for
+// them and usb_stream_stop resets, so they cannot run with audio_start or fft_core1_start.
+// Uses the ADC and DMA_IRQ_1, like audio_out_start.
+#include "src/usb_stream.h"
+
+#define USB_STREAM_BLOCKS 4
+#define USB_STREAM_RICE_ORDER 1
+
+typedef struct
+{
+    uint64_t bytes_sent;
+    uint32_t blocks_sent;
+    uint32_t dropped_blocks;
+    uint32_t sample_rate;
+    float bytes_per_second;
+} usb_stream_stats_t;
+
+int usb_stream_start(uint8_t adc_input, uint32_t sample_rate, enum usb_stream_format_enum format);
+void usb_stream_stop();
+bool usb_stream_is_connected();
+void usb_stream_get_stats(usb_stream_stats_t * stats);
+
+// UART DMA functions
+// A UART whose bytes are moved by DMA in both directions. Writes are copied to a TX ring
+// that a DMA channel drains, and a second channel writes received bytes into an RX ring
+// without stopping. The RX FIFO is always empty under DMA, so the UART's own receive
+// timeout never fires. Instead a timer checks the ring every 32 bit times (at least
+// UART_DMA_IDLE_MIN_US) and reports an idle line once data has stopped arriving.
+#define UART_DMA_RX_BITS 10 // 1 KB RX ring
+#define UART_DMA_RX_SIZE (1 << UART_DMA_RX_BITS)
+#define UART_DMA_TX_SIZE 1024
+#define UART_DMA_IDLE_MIN_US 100
+
+typedef struct
+{
+    uint32_t baud;
+    uint32_t tx_bytes;
+    uint32_t rx_bytes;
+    uint32_t rx_overruns; // Bytes lost because the RX ring was not read in time
+    uint32_t idle_events;
+} uart_dma_stats_t;
+
+int uart_dma_init(uint8_t uart_number, uint8_t tx_pin, uint8_t rx_pin, uint32_t baud);
+size_t uart_dma_write(const void * data, size_t length);
+size_t uart_dma_read(void * data, size_t length);
+size_t uart_dma_available();
+void uart_dma_set_idle_callback(void (*idle_callback)(size_t available));
+void uart_dma_get_stats(uart_dma_stats_t * stats);
+
+// Boot functions
+// Timestamps of boot phases in microseconds since the timer started in the runtime's
+// start-up code, which leaves out the few milliseconds the boot ROM takes before it.
+// "runtime init" is recorded automatically just before main.
+#define BOOT_MAX_PHASES 16
+
+typedef struct
+{
+    const char * name;
+    uint32_t time_us;
+} boot_phase_t;
+
+void boot_mark(const char * name);
+size_t boot_get_phases(const boot_phase_t ** phases);
+void boot_report();
+
+// Lazy stdio functions
+// stdio_lazy_init sets up stdio like stdio_init_all, but puts a RAM buffer in front of
+// USB. Anything printed before a host opens the port is kept, up to
+// STDIO_LAZY_BUFFER_SIZE bytes, and sent once it does, so sampling can start at once.
+// Without USB stdio it is the same as stdio_init_all.
+#define STDIO_LAZY_BUFFER_SIZE 2048
+
+void stdio_lazy_init();
+bool stdio_lazy_is_connected();
+void stdio_lazy_flush();
+uint32_t stdio_lazy_dropped();
+
+// Telemetry functions
+// The packets are in src/telemetry.h. On Pico W, telemetry_udp_open gives them a send
+// function that goes through lwIP without waiting, dropping the packet if lwIP has no
+// buffer for it. Only with a lwip_* PICO_LIBRARY_CYW43_ARCH, in pico_library_telemetry.
+#include "src/telemetry.h"
+
+int telemetry_wifi_connect(const char * ssid, const char * password, uint32_t timeout_ms);
+int telemetry_udp_open(const char * host, uint16_t port, uint32_t flush_ms);
+void telemetry_add_readings(uint8_t adc_input_mask);
+
 // GPIO functions
-void gpio_pins_change_all(uint32_t function);
-void gpio_pins_set_all_directions(uint32_t value);
-void gpio_pin_set_function(uint8_t pin, gpio_function_t function);
-void gpio_pin_disable_pulls(uint8_t pin);
-void gpio_pin_set_input_output(uint8_t pin, bool is_input);
-void gpio_pin_set_mode(uint8_t pin, bool is_input);
-void gpio_pin_set_high_low(uint8_t pin, bool is_high);
+PICO_LIBRARY_FAST void PICO_LIBRARY_HOT(gpio_pins_change_all)(uint32_t function);
+PICO_LIBRARY_FAST void PICO_LIBRARY_HOT(gpio_pins_set_all_directions)(uint32_t value);
+PICO_LIBRARY_FAST void gpio_pin_set_function(uint8_t pin, gpio_function_t function);
+PICO_LIBRARY_FAST void gpio_pin_disable_pulls(uint8_t pin);
+PICO_LIBRARY_FAST void gpio_pin_set_input_output(uint8_t pin, bool is_input);
+PICO_LIBRARY_FAST void gpio_pin_set_mode(uint8_t pin, bool is_input);
+PICO_LIBRARY_FAST void PICO_LIBRARY_HOT(gpio_pin_set_high_low)(uint8_t pin, bool is_high);
 
 // Binary functions
 #define binary_info_add_global_description(description) bi_decl(bi_program_description(description))
@@ -77,6 +612,13 @@ void gpio_pin_set_high_low(uint8_t pin, bool is_high);
 #define binary_define_variable_string(hex_tag, id, variable_name, value, max_length) bi_decl(bi_ptr_string(hex_tag, id, variable_name, value, max_length))
 
 // CPU Clock
+// The cpu_clock_get_hz_* functions count with FC0 and return 0 while it is claimed, as
+// freq_counter does for a whole direct count. Code calling frequency_count_khz itself
+// should claim FC0 around it the same way.
+extern volatile bool is_fc0_claimed;
+
+bool cpu_clock_fc0_claim();
+void cpu_clock_fc0_unclaim();
 uint64_t cpu_clock_get_hz_pll_sys();
 uint64_t cpu_clock_get_hz_pll_usb();
 uint64_t cpu_clock_get_hz_rosc();
@@ -89,46 +631,182 @@ uint64_t * cpu_clock_get_all();
 void cpu_clock_set(int hertz);
 void gpio_pin_underclock(uint8_t pin, float underclock_by, uint source);
 
+// Frequency counter functions
+// External signals on the GPIN pins, counted directly by FC0 over back to back intervals
+// of up to 32 ms until the gate time is up, or reciprocally by timing whole periods in
+// clk_sys cycles with pulse_measure, on any pin. Direct counting resolves 31.25 Hz an
+// interval at best, reciprocal counting two cycles a period, so reciprocal is better below
+// about 50 kHz. A repeating timer runs the measurement, freq_counter_start returns at once
+// and freq_counter_get_result collects it. Direct and auto counts claim FC0 for the whole
+// gate, so they fail with PICO_ERROR_RESOURCE_IN_USE while FC0 is claimed elsewhere.
+#define FREQ_COUNTER_GPIN0_PIN 20
+#define FREQ_COUNTER_GPIN1_PIN 22
+#define FREQ_COUNTER_MAX_INTERVAL_US 32113 // 0.98 us * 2^15, FC0's longest
+#define FREQ_COUNTER_RECIPROCAL_BELOW_HZ 50000
+#define FREQ_COUNTER_RECIPROCAL_TICK_US 1000
+
+enum freq_counter_mode_enum
+{
+    FREQ_COUNTER_DIRECT,
+    FREQ_COUNTER_RECIPROCAL,
+    FREQ_COUNTER_AUTO           // Direct for about a millisecond first, to choose
+};
+
+typedef struct
+{
+    double hz;
+    uint32_t samples;           // FC0 intervals or periods averaged
+    uint32_t gate_us;           // As run
+    enum freq_counter_mode_enum mode;
+} freq_counter_result_t;
+
+int freq_counter_start(uint8_t pin, uint32_t gate_us, enum freq_counter_mode_enum mode);
+bool freq_counter_is_done();
+int freq_counter_get_result(freq_counter_result_t * result);
+void freq_counter_cancel();
+double freq_counter_measure(uint8_t pin, uint32_t gate_us, enum freq_counter_mode_enum mode);
+
+// Pico W GPIO functions
+// The Pico W's LED and VBUS sense are GPIOs on the CYW43 chip, so every access is an SPI
+// transaction taking tens of microseconds. These keep a shadow of the chip's GPIOs instead.
+// A write that changes nothing returns at once, and a change is queued for a worker in the
+// cyw43 async context, so the caller never waits for SPI. VBUS is read by the same context
+// every PICO_W_VBUS_REFRESH_MS, or sooner after pico_w_vbus_refresh, and pico_w_vbus_get
+// returns the last reading. led_set and power_get_status use these on Pico W. The worker
+// runs from the cyw43 interrupt with a background PICO_LIBRARY_CYW43_ARCH, but only inside
+// cyw43_arch_poll with a poll one. Not built for boards without CYW43.
+#define PICO_W_GPIO_COUNT 3 // WL_GPIO 0 (LED), 1 (SMPS mode) and 2 (VBUS)
+#define PICO_W_VBUS_REFRESH_MS 100
+
+typedef struct
+{
+    uint32_t writes;
+    uint32_t skipped_writes;    // Writes that matched the shadow
+    uint32_t transactions;      // GPIO writes that reached the chip
+    uint32_t vbus_reads;
+} pico_w_gpio_stats_t;
+
+int pico_w_gpio_init();
+void PICO_LIBRARY_HOT(pico_w_gpio_put)(uint8_t wl_gpio, bool value);
+bool pico_w_gpio_get_shadow(uint8_t wl_gpio);
+void pico_w_gpio_flush();
+bool pico_w_vbus_get();
+void pico_w_vbus_refresh();
+void pico_w_gpio_deinit();
+void pico_w_gpio_get_stats(pico_w_gpio_stats_t * stats);
+
 // Miscellaneous Functions
 int power_get_status(bool * battery_powered);
 int power_get_voltage_status(float * voltage_result, uint8_t pin, int power_sample_count);
 void pico_w_deinit();
 
 // Utility functions
+// The double buffered DMA the ADC, audio and stream subsystems share. Two claimed channels
+// are chained to each other, so they take turns moving count transfers between buffers[i]
+// and a peripheral register, paced by dreq, each raising irq_index (0 or 1, -1 for none)
+// as it finishes. The finished channel is rewound while the other runs. dma_ping_pong_stop
+// unchains, aborts, acknowledges and unclaims them, setting channels to -1.
 bool contains_uint8_t(uint8_t array[], uint8_t value);
+void dma_channel_unchain(uint channel);
+void dma_ping_pong_configure(const int channels[2], enum dma_channel_transfer_size size, uint dreq, volatile void * peripheral, void * const buffers[2], uint count, bool is_to_peripheral, int irq_index);
+void dma_ping_pong_stop(int channels[2], uint irq_index);
 
-// Examples
-void one_without_library();
-void one_with_library();
-void two_without_library();
-void two_with_library();
-void three_without_library();
-void three_with_library();
-void four_without_library();
-void four_with_library();
-void five_without_library();
-void five_with_library();
-void six_without_library();
-void six_with_library();
-void seven_without_library();
-void seven_with_library();
-void eight_without_library();
-void eight_with_library();
-void nine_without_library();
-void nine_with_library();
-
-void ten_without_library();
-void ten_with_library();
-void eleven_without_library();
-void eleven_with_library();
-
-// Utilities for Examples
-void printhelp();
-void __not_in_flash_func(adc_capture)(uint16_t *buf, size_t count);
-float read_onboard_temperature(const char unit);
-int power_source(bool *battery_powered);
-int power_voltage(float *voltage_result);
-int pico_led_init(void);
-void pico_set_led(bool led_on);
+#ifdef PICO_LIBRARY_INLINE
+#pragma region Inline Fast Path
+
+// These skip the is_*_init checks, call the matching *_init function first.
+
+static inline void sleep(uint32_t milliseconds)
+{
+    sleep_ms(milliseconds);
+}
+
+static inline void led_set(bool led_on)
+{
+    #if defined(PICO_DEFAULT_LED_PIN)
+        gpio_put(PICO_DEFAULT_LED_PIN, led_on);
+    #elif defined(CYW43_WL_GPIO_LED_PIN)
+        pico_w_gpio_put(CYW43_WL_GPIO_LED_PIN, led_on);
+    #endif
+}
+
+static inline uint16_t adc_read_gpio_pin_raw(uint8_t adc_input)
+{
+    adc_select_input(adc_input);
+    return adc_read();
+}
+
+static inline float adc_read_gpio_pin_volts(uint8_t adc_input)
+{
+    const float conversion_factor = ADC_VOLTS_PER_CODE;
+    return adc_read_gpio_pin_raw(adc_input) * conversion_factor;
+}
+
+static inline void adc_set_temperature_sensor(bool on)
+{
+    adc_set_temp_sensor_enabled(on);
+}
+
+static inline void adc_select_pin(uint8_t pin)
+{
+    adc_select_input(pin);
+}
+
+static inline uint16_t adc_read_selected_raw()
+{
+    return adc_read();
+}
+
+static inline float adc_read_selected_volts()
+{
+    const float conversion_factor = ADC_VOLTS_PER_CODE;
+    return adc_read() * conversion_factor;
+}
+
+static inline void gpio_pins_change_all(uint32_t function)
+{
+    gpio_put_all(function);
+}
+
+static inline void gpio_pins_set_all_directions(uint32_t value)
+{
+    gpio_set_dir_all_bits(value);
+}
+
+static inline void gpio_pin_set_function(uint8_t pin, gpio_function_t function)
+{
+    gpio_set_function(pin, function);
+}
+
+static inline void gpio_pin_disable_pulls(uint8_t pin)
+{
+    gpio_disable_pulls(pin);
+}
+
+static inline void gpio_pin_set_input_output(uint8_t pin, bool is_input)
+{
+    gpio_set_input_enabled(pin, is_input);
+}
+
+static inline void gpio_pin_set_mode(uint8_t pin, bool high_voltage)
+{
+    if (high_voltage)
+    {
+        gpio_pull_up(pin);
+    }
+
+    else
+    {
+        gpio_pull_down(pin);
+    }
+}
+
+static inline void gpio_pin_set_high_low(uint8_t pin, bool is_high)
+{
+    gpio_put(pin, is_high);
+}
+
+#pragma endregion
+#endif
 
 #endif
@@ -0,0 +1,212 @@
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/adc.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/sio.h"
+
+#ifndef PICOLIBRARY_HPP_
+#define PICOLIBRARY_HPP_
+
+// Compile-time checked pins and ADC channels for C++17.
+//
+// Everything here is resolved by the compiler: masks, slice numbers and register
+// addresses are constexpr values, and a pin that cannot serve the requested
+// function fails the build through static_assert instead of misbehaving at runtime.
+//
+//     using Led = pico_library::Pin<25>;
+//     using Joystick = pico_library::AdcPin<26>;   // AdcChannel<0>
+//     using Measure = pico_library::PwmInput<5>;   // PwmInput<4> does not build
+//
+//     Led::init_output();
+//     Led::set_high_low(Joystick::read_raw() > 2048);
+
+namespace pico_library
+{
+    constexpr uint8_t FIRST_ADC_PIN = 26;
+    constexpr uint8_t TEMPERATURE_SENSOR_INPUT = 4;
+    constexpr float ADC_CONVERSION_FACTOR = 3.3f / (1 << 12);
+
+    #pragma region Pin
+
+    template <uint8_t N>
+    struct Pin
+    {
+        static_assert(N < NUM_BANK0_GPIOS, "Pin: the RP2040 only has GPIO 0 to 29");
+
+        static constexpr uint8_t number = N;
+        static constexpr uint32_t mask = 1u << N;
+
+        // Pin functions, see the GPIO function table in the RP2040 datasheet.
+        static constexpr bool is_adc = N >= FIRST_ADC_PIN && N < FIRST_ADC_PIN + 4;
+        static constexpr bool is_pwm_b = (N & 1) != 0;
+        static constexpr bool is_gpout = N == 21 || N == 23 || N == 24 || N == 25;
+        static constexpr bool is_gpin = N == 20 || N == 22;
+
+        static constexpr uint pwm_slice = (N >> 1) & 7;
+        static constexpr uint pwm_channel = N & 1;
+
+        // SIO registers used for this pin, the same ones gpio_put writes to.
+        static constexpr uintptr_t gpio_in_address = SIO_BASE + SIO_GPIO_IN_OFFSET;
+        static constexpr uintptr_t gpio_set_address = SIO_BASE + SIO_GPIO_OUT_SET_OFFSET;
+        static constexpr uintptr_t gpio_clear_address = SIO_BASE + SIO_GPIO_OUT_CLR_OFFSET;
+        static constexpr uintptr_t gpio_toggle_address = SIO_BASE + SIO_GPIO_OUT_XOR_OFFSET;
+
+        static void init_output()
+        {
+            gpio_init(N);
+            gpio_set_dir(N, GPIO_OUT);
+        }
+
+        static void init_input()
+        {
+            gpio_init(N);
+            gpio_set_dir(N, GPIO_IN);
+        }
+
+        static void set_function(gpio_function_t function)
+        {
+            gpio_set_function(N, function);
+        }
+
+        static void set_high_low(bool is_high)
+        {
+            *reinterpret_cast<volatile uint32_t *>(is_high ? gpio_set_address : gpio_clear_address) = mask;
+        }
+
+        static void toggle()
+        {
+            *reinterpret_cast<volatile uint32_t *>(gpio_toggle_address) = mask;
+        }
+
+        static bool get()
+        {
+            return (*reinterpret_cast<volatile uint32_t *>(gpio_in_address) & mask) != 0;
+        }
+    };
+
+    #pragma endregion
+    #pragma region ADC
+
+    template <uint8_t N>
+    struct AdcChannel
+    {
+        static_assert(N <= TEMPERATURE_SENSOR_INPUT, "AdcChannel: inputs 0 to 3 are GPIO 26 to 29, input 4 is the temperature sensor");
+
+        static constexpr uint8_t input = N;
+        static constexpr bool is_temperature_sensor = N == TEMPERATURE_SENSOR_INPUT;
+        static constexpr uint8_t pin = N + FIRST_ADC_PIN;
+        static constexpr uint32_t ainsel_bits = uint32_t(N) << ADC_CS_AINSEL_LSB;
+
+        static void init()
+        {
+            adc_init();
+
+            if constexpr (is_temperature_sensor)
+            {
+                adc_set_temp_sensor_enabled(true);
+            }
+
+            else
+            {
+                // Make sure GPIO is high-impedance, no pullups etc.
+                adc_gpio_init(pin);
+            }
+        }
+
+        static void select()
+        {
+            hw_write_masked(&adc_hw->cs, ainsel_bits, ADC_CS_AINSEL_BITS);
+        }
+
+        static uint16_t read_raw()
+        {
+            select();
+            return adc_read();
+        }
+
+        static float read_volts()
+        {
+            return read_raw() * ADC_CONVERSION_FACTOR;
+        }
+    };
+
+    using TemperatureSensor = AdcChannel<TEMPERATURE_SENSOR_INPUT>;
+
+    // Same channel as AdcChannel<N - 26>, named by its GPIO instead.
+    template <uint8_t N>
+    struct AdcPin : AdcChannel<Pin<N>::is_adc ? N - FIRST_ADC_PIN : 0>
+    {
+        static_assert(Pin<N>::is_adc, "AdcPin: only GPIO 26 to 29 are connected to the ADC");
+    };
+
+    #pragma endregion
+    #pragma region PWM
+
+    template <uint8_t N>
+    struct PwmOutput : Pin<N>
+    {
+        static constexpr uint slice = Pin<N>::pwm_slice;
+        static constexpr uint channel = Pin<N>::pwm_channel;
+
+        static void init(uint16_t wrap)
+        {
+            pwm_config cfg = pwm_get_default_config();
+            pwm_config_set_wrap(&cfg, wrap);
+            pwm_init(slice, &cfg, true);
+            gpio_set_function(N, GPIO_FUNC_PWM);
+        }
+
+        static void set_level(uint16_t level)
+        {
+            pwm_set_chan_level(slice, channel, level);
+        }
+    };
+
+    template <uint8_t N>
+    struct PwmInput : Pin<N>
+    {
+        static_assert(Pin<N>::is_pwm_b, "PwmInput: only the PWM B pins (odd GPIOs) can be used as inputs");
+
+        static constexpr uint slice = Pin<N>::pwm_slice;
+
+        // Fraction of a 10 ms window the pin was high, see measure_duty_cycle.
+        static float measure_duty_cycle()
+        {
+            // Count once for every 100 cycles the PWM B input is high
+            pwm_config cfg = pwm_get_default_config();
+            pwm_config_set_clkdiv_mode(&cfg, PWM_DIV_B_HIGH);
+            pwm_config_set_clkdiv(&cfg, 100);
+            pwm_init(slice, &cfg, false);
+            gpio_set_function(N, GPIO_FUNC_PWM);
+
+            pwm_set_enabled(slice, true);
+            sleep_ms(10);
+            pwm_set_enabled(slice, false);
+            float counting_rate = clock_get_hz(clk_sys) / 100;
+            float max_possible_count = counting_rate * 0.01f;
+            return pwm_get_counter(slice) / max_possible_count;
+        }
+    };
+
+    #pragma endregion
+    #pragma region Clock Output
+
+    template <uint8_t N>
+    struct GpoutPin : Pin<N>
+    {
+        static_assert(Pin<N>::is_gpout, "GpoutPin: clock outputs are only on GPIO 21, 23, 24 and 25");
+
+        // GPIO 21 is clk_gpout0, 23 is clk_gpout1, 24 is clk_gpout2 and 25 is clk_gpout3.
+        static constexpr uint gpout = N == 21 ? 0 : N - 22;
+
+        static void underclock(float underclock_by, uint source)
+        {
+            clock_gpio_init(N, source, underclock_by);
+        }
+    };
+
+    #pragma endregion
+}
+
+#endif
@@ -0,0 +1,90 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 18 (Hot Path Placement)
+
+#define PLACEMENT_PIN 15
+#define PLACEMENT_ITERATIONS 1000
+
+uint16_t placement_samples[FFT_MIN_POINTS] __aligned(4);
+int16_t placement_output[FFT_MIN_POINTS];
+fft_complex_t placement_data[FFT_MIN_POINTS];
+
+static void placement_report(const string name, uint32_t cycles, const xip_cache_stats_t * stats)
+{
+    printf("%-22s %8lu cycles, XIP %7lu accesses, %6lu misses\n", name, cycles, stats->accesses, stats->accesses - stats->hits);
+}
+
+void eighteen_with_library()
+{
+    stdio_init_all();
+    gpio_pin_init(PLACEMENT_PIN);
+    gpio_set_dir(PLACEMENT_PIN, GPIO_OUT);
+    adc_input_init(0);
+    adc_select_pin(0);
+    cycle_counter_start();
+
+    const uint32_t bar_scale = convert_scale_factor(40, (1 << 12) - 1);
+    const string placement[] = {"flash", "SRAM"};
+    xip_cache_stats_t stats;
+
+    while (true)
+    {
+        printf("\nHot paths in %s\n", placement[PICO_LIBRARY_HOT_PATHS]);
+
+        xip_cache_stats_reset();
+        uint32_t start = cycle_counter_get();
+
+        for (int i = 0; i < PLACEMENT_ITERATIONS; i++)
+        {
+            gpio_pin_set_high_low(PLACEMENT_PIN, true);
+            gpio_pin_set_high_low(PLACEMENT_PIN, false);
+        }
+
+        uint32_t cycles = cycle_counter_elapsed(start);
+        xip_cache_stats_get(&stats);
+        placement_report("gpio_pin_set_high_low", cycles, &stats);
+
+        xip_cache_stats_reset();
+        start = cycle_counter_get();
+        adc_capture(placement_samples, FFT_MIN_POINTS);
+        cycles = cycle_counter_elapsed(start);
+        xip_cache_stats_get(&stats);
+        placement_report("adc_capture", cycles, &stats);
+
+        xip_cache_stats_reset();
+        start = cycle_counter_get();
+        convert_scale_clamp_batch(placement_samples, (uint16_t *) placement_output, FFT_MIN_POINTS, bar_scale, 0, 39);
+        cycles = cycle_counter_elapsed(start);
+        xip_cache_stats_get(&stats);
+        placement_report("convert_scale_clamp", cycles, &stats);
+
+        xip_cache_stats_reset();
+        start = cycle_counter_get();
+
+        for (int i = 0; i < PLACEMENT_ITERATIONS; i++)
+        {
+            debounce_tick(i & 4 ? 0x0ffffffc : 0);
+        }
+
+        cycles = cycle_counter_elapsed(start);
+        xip_cache_stats_get(&stats);
+        placement_report("debounce_tick", cycles, &stats);
+
+        fft_load_samples(placement_data, placement_samples, FFT_MIN_POINTS, true);
+        xip_cache_stats_reset();
+        start = cycle_counter_get();
+        fft_transform(placement_data, FFT_MIN_POINTS);
+        cycles = cycle_counter_elapsed(start);
+        xip_cache_stats_get(&stats);
+        placement_report("fft_transform", cycles, &stats);
+
+        sleep(2000);
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    eighteen_with_library();
+}
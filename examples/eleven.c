@@ -0,0 +1,135 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 11 (Hello 48 MHz)
+
+void eleven_without_library() 
+{
+    stdio_init_all();
+
+    printf("Hello, world!\n");
+
+    uint f_pll_sys = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_PLL_SYS_CLKSRC_PRIMARY);
+    uint f_pll_usb = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_PLL_USB_CLKSRC_PRIMARY);
+    uint f_rosc = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_ROSC_CLKSRC);
+    uint f_clk_sys = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_SYS);
+    uint f_clk_peri = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_PERI);
+    uint f_clk_usb = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_USB);
+    uint f_clk_adc = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_ADC);
+
+    #ifdef CLOCKS_FC0_SRC_VALUE_CLK_RTC
+        uint f_clk_rtc = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_RTC);
+    #endif
+
+    printf("pll_sys  = %dkHz\n", f_pll_sys);
+    printf("pll_usb  = %dkHz\n", f_pll_usb);
+    printf("rosc     = %dkHz\n", f_rosc);
+    printf("clk_sys  = %dkHz\n", f_clk_sys);
+    printf("clk_peri = %dkHz\n", f_clk_peri);
+    printf("clk_usb  = %dkHz\n", f_clk_usb);
+    printf("clk_adc  = %dkHz\n", f_clk_adc);
+
+    #ifdef CLOCKS_FC0_SRC_VALUE_CLK_RTC
+        printf("clk_rtc  = %dkHz\n", f_clk_rtc);
+    #endif
+
+    // Can't measure clk_ref / xosc as it is the ref
+
+    // Change clk_sys to be 48MHz. The simplest way is to take this from PLL_USB
+    // which has a source frequency of 48MHz
+    clock_configure(clk_sys,
+                    CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                    CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB,
+                    48 * MHZ,
+                    48 * MHZ);
+
+    // Turn off PLL sys for good measure
+    pll_deinit(pll_sys);
+
+    // CLK peri is clocked from clk_sys so need to change clk_peri's freq
+    clock_configure(clk_peri,
+                    0,
+                    CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLK_SYS,
+                    48 * MHZ,
+                    48 * MHZ);
+
+    // Re init uart now that clk_peri has changed
+    stdio_init_all();
+
+    f_pll_sys = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_PLL_SYS_CLKSRC_PRIMARY);
+    f_pll_usb = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_PLL_USB_CLKSRC_PRIMARY);
+    f_rosc = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_ROSC_CLKSRC);
+    f_clk_sys = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_SYS);
+    f_clk_peri = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_PERI);
+    f_clk_usb = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_USB);
+    f_clk_adc = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_ADC);
+
+    #ifdef CLOCKS_FC0_SRC_VALUE_CLK_RTC
+        f_clk_rtc = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_CLK_RTC);
+    #endif
+
+    printf("pll_sys  = %dkHz\n", f_pll_sys);
+    printf("pll_usb  = %dkHz\n", f_pll_usb);
+    printf("rosc     = %dkHz\n", f_rosc);
+    printf("clk_sys  = %dkHz\n", f_clk_sys);
+    printf("clk_peri = %dkHz\n", f_clk_peri);
+    printf("clk_usb  = %dkHz\n", f_clk_usb);
+    printf("clk_adc  = %dkHz\n", f_clk_adc);
+
+    #ifdef CLOCKS_FC0_SRC_VALUE_CLK_RTC
+        printf("clk_rtc  = %dkHz\n", f_clk_rtc);
+    #endif
+
+    // Can't measure clk_ref / xosc as it is the ref
+
+    printf("Hello, 48MHz");
+}
+
+void eleven_with_library() 
+{
+    stdio_init_all();
+
+    printf("Hello, world!\n");
+
+    uint64_t * hz = cpu_clock_get_all();
+
+    printf("pll_sys  = %d Hz\n", hz[0]);
+    printf("pll_usb  = %d Hz\n", hz[1]);
+    printf("rosc     = %d Hz\n", hz[2]);
+    printf("clk_sys  = %d Hz\n", hz[3]);
+    printf("clk_peri = %d Hz\n", hz[4]);
+    printf("clk_usb  = %d Hz\n", hz[5]);
+    printf("clk_adc  = %d Hz\n", hz[6]);
+
+    #ifdef CLOCKS_FC0_SRC_VALUE_CLK_RTC
+        printf("clk_rtc  = %dkHz\n", hz[7]);
+    #endif
+
+    cpu_clock_set(48 * MHZ);
+
+    hz = cpu_clock_get_all();
+
+    printf("pll_sys  = %d Hz\n", hz[0]);
+    printf("pll_usb  = %d Hz\n", hz[1]);
+    printf("rosc     = %d Hz\n", hz[2]);
+    printf("clk_sys  = %d Hz\n", hz[3]);
+    printf("clk_peri = %d Hz\n", hz[4]);
+    printf("clk_usb  = %d Hz\n", hz[5]);
+    printf("clk_adc  = %d Hz\n", hz[6]);
+
+    #ifdef CLOCKS_FC0_SRC_VALUE_CLK_RTC
+        printf("clk_rtc  = %dkHz\n", hz[7]);
+    #endif
+
+    printf("Hello, 48MHz");
+}
+
+#pragma endregion
+
+int main()
+{
+    #ifdef EXAMPLE_WITHOUT_LIBRARY
+        eleven_without_library();
+    #else
+        eleven_with_library();
+    #endif
+}
@@ -0,0 +1,85 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 15 (Interpolator Conversions)
+
+#define CONVERT_SAMPLES 1024
+
+uint16_t convert_raw[CONVERT_SAMPLES] __aligned(4);
+int16_t convert_output[CONVERT_SAMPLES];
+float convert_float_output[CONVERT_SAMPLES];
+int16_t convert_millivolts[CONVERT_TABLE_SIZE];
+int16_t convert_temperature[CONVERT_TABLE_SIZE];
+
+void fifteen_with_library()
+{
+    stdio_init_all();
+    adc_input_init(0);
+    adc_select_pin(0);
+    cycle_counter_start();
+
+    convert_table_millivolts(convert_millivolts);
+    convert_table_temperature(convert_temperature);
+
+    const uint bar_width = 40;
+    const uint adc_max = (1 << 12) - 1;
+    const uint32_t bar_scale = convert_scale_factor(bar_width, adc_max);
+
+    while (true)
+    {
+        adc_capture(convert_raw, CONVERT_SAMPLES);
+
+        // Generic C loops, as used in the examples.
+        uint32_t start = cycle_counter_get();
+        const float conversion_factor = 3.3f / (1 << 12);
+
+        for (int i = 0; i < CONVERT_SAMPLES; i++)
+        {
+            convert_float_output[i] = convert_raw[i] * conversion_factor;
+        }
+
+        uint32_t volts_cycles = cycle_counter_elapsed(start);
+        start = cycle_counter_get();
+
+        for (int i = 0; i < CONVERT_SAMPLES; i++)
+        {
+            convert_float_output[i] = 27.0f - (convert_raw[i] * conversion_factor - 0.706f) / 0.001721f;
+        }
+
+        uint32_t temperature_cycles = cycle_counter_elapsed(start);
+        start = cycle_counter_get();
+
+        for (int i = 0; i < CONVERT_SAMPLES; i++)
+        {
+            convert_output[i] = convert_raw[i] * bar_width / adc_max;
+        }
+
+        uint32_t bar_cycles = cycle_counter_elapsed(start);
+
+        // Interpolator kernels.
+        start = cycle_counter_get();
+        convert_lookup_batch(convert_raw, convert_output, CONVERT_SAMPLES, convert_millivolts);
+        uint32_t lookup_volts_cycles = cycle_counter_elapsed(start);
+
+        start = cycle_counter_get();
+        convert_lookup_batch(convert_raw, convert_output, CONVERT_SAMPLES, convert_temperature);
+        uint32_t lookup_temperature_cycles = cycle_counter_elapsed(start);
+
+        start = cycle_counter_get();
+        convert_scale_clamp_batch(convert_raw, (uint16_t *) convert_output, CONVERT_SAMPLES, bar_scale, 0, bar_width - 1);
+        uint32_t clamp_bar_cycles = cycle_counter_elapsed(start);
+
+        printf("cycles/sample  volts %.1f -> %.1f, temperature %.1f -> %.1f, bar %.1f -> %.1f\n",
+               (float) volts_cycles / CONVERT_SAMPLES, (float) lookup_volts_cycles / CONVERT_SAMPLES,
+               (float) temperature_cycles / CONVERT_SAMPLES, (float) lookup_temperature_cycles / CONVERT_SAMPLES,
+               (float) bar_cycles / CONVERT_SAMPLES, (float) clamp_bar_cycles / CONVERT_SAMPLES);
+
+        sleep(1000);
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    fifteen_with_library();
+}
@@ -0,0 +1,295 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 5 (ADC Console)
+
+#define N_SAMPLES 1000
+
+// Only for the SDK version, the library's captures go into a sample pool block.
+uint16_t sample_buf[N_SAMPLES];
+_Static_assert(N_SAMPLES * sizeof(uint16_t) <= SAMPLE_POOL_BLOCK_SIZE, "A capture must fit in a sample pool block");
+
+void printhelp() 
+{
+    puts("\nCommands:");
+    puts("c0, ...\t: Select ADC channel n");
+    puts("s\t: Sample once");
+    #ifdef EXAMPLE_WITHOUT_LIBRARY
+        puts("S\t: Sample many");
+    #else
+        puts("S\t: Sample many on a rising edge through mid-scale");
+    #endif
+    puts("w\t: Wiggle pins");
+    #ifndef EXAMPLE_WITHOUT_LIBRARY
+        puts("b\t: Binary RPC until RPC_EXIT");
+    #endif
+}
+
+void five_without_library() 
+{
+    stdio_init_all();
+    adc_init();
+    adc_set_temp_sensor_enabled(true);
+
+    // Set all pins to input (as far as SIO is concerned)
+    gpio_set_dir_all_bits(0);
+
+    for (int i = 2; i < 30; ++i) 
+    {
+        gpio_set_function(i, GPIO_FUNC_SIO);
+        if (i >= 26) 
+        {
+            gpio_disable_pulls(i);
+            gpio_set_input_enabled(i, false);
+        }
+    }
+
+    printf("\n===========================\n");
+    printf("RP2040 ADC and Test Console\n");
+    printf("===========================\n");
+    printhelp();
+
+    while (true) 
+    {
+        char c = getchar();
+        printf("%c", c);
+        switch (c) 
+        {
+            case 'c':
+            {
+                c = getchar();
+                printf("%c\n", c);
+                if (c < '0' || c > '7') 
+                {
+                    printf("Unknown input channel\n");
+                    printhelp();
+                } 
+                
+                else 
+                {
+                    adc_select_input(c - '0');
+                    printf("Switched to channel %c\n", c);
+                }
+
+                break;
+            }
+
+            case 's': 
+            {
+                uint32_t result = adc_read();
+                const float conversion_factor = 3.3f / (1 << 12);
+                printf("\n0x%03x -> %f V\n", result, result * conversion_factor);
+                break;
+            }
+            
+            case 'S': 
+            {
+                printf("\nStarting capture\n");
+                adc_capture(sample_buf, N_SAMPLES);
+                printf("Done\n");
+                for (int i = 0; i < N_SAMPLES; i = i + 1)
+                {
+                    printf("%03x\n", sample_buf[i]);
+                }
+                break;
+            }
+
+            case 'w': 
+            {
+                printf("\nPress any key to stop wiggling\n");
+                int i = 1;
+                gpio_set_dir_all_bits(-1);
+                while (getchar_timeout_us(0) == PICO_ERROR_TIMEOUT) 
+                {
+                    // Pattern: Flash all pins for a cycle,
+                    // Then scan along pins for one cycle each
+                    i = i ? i << 1 : 1;
+                    gpio_put_all(i ? i : ~0);
+                }
+
+                gpio_set_dir_all_bits(0);
+                printf("Wiggling halted.\n");
+
+                break;
+            }
+
+            case '\n':
+            case '\r':
+                break;
+            case 'h':
+                printhelp();
+                break;
+            default:
+                printf("\nUnrecognised command: %c\n", c);
+                printhelp();
+                break;
+        }
+    }
+}
+
+void five_with_library() 
+{
+    stdio_init_all();
+    adc_library_init();
+    adc_set_temperature_sensor(true);
+
+    // Set all pins to input (as far as SIO is concerned).
+    gpio_pins_set_all_directions(0);
+
+    for (int i = 2; i < 30; ++i) 
+    {
+        gpio_pin_init(i);
+        gpio_pin_set_function(i, GPIO_FUNC_SIO);
+        if (i >= 26) 
+        {
+            gpio_pin_disable_pulls(i);
+            gpio_pin_set_input_output(i, false);
+        }
+    }
+
+    printf("\n===========================\n");
+    printf("RP2040 ADC and Test Console\n");
+    printf("===========================\n");
+    printhelp();
+
+    while (true) 
+    {
+        char c = getchar();
+        printf("%c", c);
+        switch (c) 
+        {
+            case 'c':
+            {
+                c = getchar();
+                printf("%c\n", c);
+                if (c < '0' || c > '7') 
+                {
+                    printf("Unknown input channel\n");
+                    printhelp();
+                } 
+                
+                else 
+                {
+                    adc_select_input(c - '0');
+                    printf("Switched to channel %c\n", c);
+                }
+
+                break;
+            }
+
+            case 's': 
+            {
+                uint32_t result = adc_read_selected_raw();
+                const float conversion_factor = 3.3f / (1 << 12);
+                printf("\n0x%03x -> %f V\n", result, result * conversion_factor);
+                break;
+            }
+            
+            case 'S': 
+            {
+                // A fifth of the samples are from before the trigger.
+                adc_trigger_config_t config =
+                {
+                    .mode = ADC_TRIGGER_RISING,
+                    .level = 0x800,
+                    .hysteresis = 0x40,
+                    .pre_samples = N_SAMPLES / 5,
+                    .post_samples = N_SAMPLES - N_SAMPLES / 5
+                };
+
+                if (adc_trigger_start(adc_get_selected_input(), 500000, &config) != PICO_OK)
+                {
+                    printf("\nNo triggered capture on this channel\n");
+                    break;
+                }
+
+                block_pool_t * pool = sample_pool_get();
+                uint16_t * samples = pool != NULL ? block_pool_alloc(pool) : NULL;
+
+                if (samples == NULL)
+                {
+                    adc_trigger_stop();
+                    printf("\nNo sample buffer free\n");
+                    break;
+                }
+
+                printf("\nWaiting for trigger, press any key to stop\n");
+                int count;
+
+                do
+                {
+                    count = adc_trigger_wait(samples, 100000);
+                }
+                while (count == PICO_ERROR_TIMEOUT && getchar_timeout_us(0) == PICO_ERROR_TIMEOUT);
+
+                adc_trigger_stop();
+
+                if (count < 0)
+                {
+                    printf("Capture stopped.\n");
+                }
+
+                else
+                {
+                    printf("Triggered at sample %d\n", N_SAMPLES / 5);
+
+                    for (int i = 0; i < count; i = i + 1)
+                    {
+                        printf("%03x\n", samples[i]);
+                    }
+                }
+
+                block_pool_release(pool, samples);
+                break;
+            }
+
+            case 'w': 
+            {
+                printf("\nPress any key to stop wiggling\n");
+                int i = 1;
+                gpio_pins_set_all_directions(-1);
+
+                while (getchar_timeout_us(0) == PICO_ERROR_TIMEOUT) 
+                {
+                    // Pattern: Flash all pins for a cycle,
+                    // Then scan along pins for one cycle each
+                    i = i ? i << 1 : 1;
+                    gpio_pins_change_all(i ? i : ~0);
+                }
+
+                gpio_pins_set_all_directions(0);
+                printf("Wiggling halted.\n");
+                break;
+            }
+
+            case 'b':
+            {
+                printf("\nBinary RPC mode\n");
+                rpc_serve();
+                printf("Binary RPC ended.\n");
+                break;
+            }
+
+            case '\n':
+            case '\r':
+                break;
+            case 'h':
+                printhelp();
+                break;
+            default:
+                printf("\nUnrecognised command: %c\n", c);
+                printhelp();
+                break;
+        }
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    #ifdef EXAMPLE_WITHOUT_LIBRARY
+        five_without_library();
+    #else
+        five_with_library();
+    #endif
+}
@@ -0,0 +1,96 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 4 (Joystick Display)
+
+void four_without_library() 
+{
+    stdio_init_all();
+    adc_init();
+    // Make sure GPIO is high-impedance, no pullups etc
+    adc_gpio_init(26);
+    adc_gpio_init(27);
+
+    while (true) 
+    {
+        adc_select_input(0);
+        uint adc_x_raw = adc_read();
+        adc_select_input(1);
+        uint adc_y_raw = adc_read();
+
+        // Display the joystick position something like this:
+        // X: [            o             ]  Y: [              o         ]
+
+        const uint bar_width = 40;
+        const uint adc_max = (1 << 12) - 1;
+
+        uint bar_x_pos = adc_x_raw * bar_width / adc_max;
+        uint bar_y_pos = adc_y_raw * bar_width / adc_max;
+
+        printf("\rX: [");
+
+        for (uint i = 0; i < bar_width; ++i)
+        {
+            putchar( i == bar_x_pos ? 'o' : ' ');
+        }
+
+        printf("]  Y: [");
+
+        for (uint i = 0; i < bar_width; ++i)
+        {
+            putchar( i == bar_y_pos ? 'o' : ' ');
+        }
+
+        printf("]");
+        sleep_ms(50);
+    }
+}
+
+void four_with_library() 
+{
+    stdio_init_all();
+    adc_input_init(0);
+    adc_input_init(1);
+
+    while (true) 
+    {
+        uint adc_x_raw = adc_read_gpio_pin_raw(0);
+        uint adc_y_raw = adc_read_gpio_pin_raw(1);
+
+        // Display the joystick position something like this:
+        // X: [            o             ]  Y: [              o         ]
+
+        const uint bar_width = 40;
+        const uint adc_max = (1 << 12) - 1;
+
+        uint bar_x_pos = adc_x_raw * bar_width / adc_max;
+        uint bar_y_pos = adc_y_raw * bar_width / adc_max;
+
+        printf("\rX: [");
+
+        for (uint i = 0; i < bar_width; ++i)
+        {
+            putchar( i == bar_x_pos ? 'o' : ' ');
+        }
+
+        printf("]  Y: [");
+
+        for (uint i = 0; i < bar_width; ++i)
+        {
+            putchar( i == bar_y_pos ? 'o' : ' ');
+        }
+
+        printf("]");
+        sleep(50);
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    #ifdef EXAMPLE_WITHOUT_LIBRARY
+        four_without_library();
+    #else
+        four_with_library();
+    #endif
+}
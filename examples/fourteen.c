@@ -0,0 +1,54 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 14 (Spectrum Analyser)
+
+#define SPECTRUM_POINTS 1024
+#define SPECTRUM_SAMPLE_RATE 10000
+
+uint16_t spectrum_samples[SPECTRUM_POINTS];
+fft_complex_t spectrum_data[SPECTRUM_POINTS];
+uint16_t spectrum_magnitude[SPECTRUM_POINTS / 2];
+
+void fourteen_with_library()
+{
+    stdio_init_all();
+    printf("Spectrum analyser on ADC input 0\n");
+
+    adc_input_init(0);
+    adc_select_pin(0);
+    adc_set_clkdiv(48000000.0f / SPECTRUM_SAMPLE_RATE - 1);
+
+    // Core1 transforms one block while this core captures the next.
+    fft_core1_start();
+
+    fft_job_t job = {0};
+    job.data = spectrum_data;
+    job.magnitude = spectrum_magnitude;
+    job.points = SPECTRUM_POINTS;
+
+    bool has_result = false;
+
+    while (true)
+    {
+        adc_capture(spectrum_samples, SPECTRUM_POINTS);
+        fft_core1_wait(&job);
+
+        if (has_result)
+        {
+            printf("Peak %7.1f Hz (bin %u, magnitude %u), %lu cycles\n",
+                   fft_bin_frequency(job.peak_bin, SPECTRUM_POINTS, SPECTRUM_SAMPLE_RATE),
+                   job.peak_bin, spectrum_magnitude[job.peak_bin], job.cycles);
+        }
+
+        fft_load_samples(spectrum_data, spectrum_samples, SPECTRUM_POINTS, true);
+        fft_core1_submit(&job);
+        has_result = true;
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    fourteen_with_library();
+}
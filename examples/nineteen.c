@@ -0,0 +1,33 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 19 (USB Streaming)
+
+// Streams GPIO 26 at the ADC's full rate over the vendor bulk endpoint, while stdio
+// keeps working over the CDC interface next to it.
+#define STREAM_ADC_INPUT 0
+#define STREAM_SAMPLE_RATE 500000
+
+void nineteen_with_library()
+{
+    stdio_init_all();
+    hard_assert(usb_stream_start(STREAM_ADC_INPUT, STREAM_SAMPLE_RATE, USB_STREAM_16_BIT) == PICO_OK);
+
+    while (true)
+    {
+        sleep(1000);
+
+        usb_stream_stats_t stats;
+        usb_stream_get_stats(&stats);
+
+        printf("%s: %lu blocks sent, %lu dropped, %.0f kB/s\n",
+               usb_stream_is_connected() ? "Streaming" : "Waiting for host",
+               stats.blocks_sent, stats.dropped_blocks, stats.bytes_per_second / 1000.0f);
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    nineteen_with_library();
+}
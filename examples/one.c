@@ -0,0 +1,32 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 1 (Hello World)
+    void one_without_library() 
+    {
+        stdio_init_all();
+        while (true) 
+        {
+            printf("Hello, world!\n");
+            sleep_ms(1000);
+        }
+    }
+
+    void one_with_library() 
+    {
+        stdio_init_all();
+        while (true) 
+        {
+            printf("Hello, world!\n");
+            sleep(1000);
+        }
+    }
+#pragma endregion
+
+int main()
+{
+    #ifdef EXAMPLE_WITHOUT_LIBRARY
+        one_without_library();
+    #else
+        one_with_library();
+    #endif
+}
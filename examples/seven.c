@@ -0,0 +1,78 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 7 (ADC Microphone)
+
+void seven_without_library() 
+{
+    #define ADC_NUM 0
+    #define ADC_PIN (26 + ADC_NUM)
+    #define ADC_VREF 3.3
+    #define ADC_RANGE (1 << 12)
+    #define ADC_CONVERT (ADC_VREF / (ADC_RANGE - 1))
+
+    stdio_init_all();
+    printf("Beep boop, listening...\n");
+
+    bi_decl(bi_program_description("Analog microphone example for Raspberry Pi Pico")); // for picotool
+    bi_decl(bi_1pin_with_name(ADC_PIN, "ADC input pin"));
+
+    adc_init();
+    adc_gpio_init( ADC_PIN);
+    adc_select_input( ADC_NUM);
+
+    uint adc_raw;
+    
+    while (true) 
+    {
+        adc_raw = adc_read(); // raw voltage from ADC
+        printf("%.2f\n", adc_raw * ADC_CONVERT);
+        sleep_ms(10);
+    }
+}
+
+#define MICROPHONE_SAMPLE_RATE 32000
+#define MICROPHONE_DECIMATION 4
+
+void seven_with_library() 
+{
+    #define ADC_NUM 0
+    #define ADC_PIN (26 + ADC_NUM)
+
+    stdio_init_all();
+    printf("Beep boop, listening...\n");
+    
+    // Binary info canot be made into functions.
+    binary_info_add_global_description("Analog microphone example for Raspberry Pi Pico"); // for picotool
+    binary_info_name_pin(ADC_PIN, "ADC input pin");
+
+    // Sampling, filtering and levels all run on core1, this core only reports them.
+    hard_assert(audio_start(ADC_NUM, MICROPHONE_SAMPLE_RATE, MICROPHONE_DECIMATION, NULL) == PICO_OK);
+
+    audio_stats_t stats = {0};
+    
+    while (true) 
+    {
+        sleep(500);
+
+        if (audio_get_stats(&stats))
+        {
+            printf("RMS %5u, peak %5u, level %6.1f dBFS, dropped %lu | cycles/sample: convert %.1f, dc %.1f, fir %.1f, measure %.1f\n",
+                   stats.rms, stats.peak, stats.level_db, stats.dropped_blocks,
+                   (float) stats.convert_cycles / AUDIO_BLOCK_SIZE,
+                   (float) stats.dc_cycles / AUDIO_BLOCK_SIZE,
+                   (float) stats.fir_cycles / AUDIO_BLOCK_SIZE,
+                   (float) stats.measure_cycles / stats.output_count);
+        }
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    #ifdef EXAMPLE_WITHOUT_LIBRARY
+        seven_without_library();
+    #else
+        seven_with_library();
+    #endif
+}
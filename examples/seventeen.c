@@ -0,0 +1,50 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 17 (Debounced Buttons)
+
+// Buttons to ground on GPIO 2 to 22, using the internal pull ups.
+#define BUTTON_PINS 0x007ffffc
+#define BUTTON_TICK_US 1000
+#define BUTTON_HOLD_TICKS 800
+
+void seventeen_with_library()
+{
+    stdio_init_all();
+    printf("\nDebouncing GPIO 2 to 22\n");
+
+    // Time the tick on its own first, its cost does not depend on how many pins change.
+    cycle_counter_start();
+    debounce_reset(BUTTON_PINS, BUTTON_PINS, BUTTON_HOLD_TICKS);
+
+    uint32_t start = cycle_counter_get();
+
+    for (int i = 0; i < 1000; i++)
+    {
+        debounce_tick(i & 4 ? BUTTON_PINS : 0);
+    }
+
+    printf("debounce_tick: %.1f cycles per tick\n", cycle_counter_elapsed(start) / 1000.0f);
+
+    hard_assert(debounce_start(BUTTON_PINS, BUTTON_PINS, BUTTON_TICK_US, BUTTON_HOLD_TICKS) == PICO_OK);
+
+    while (true)
+    {
+        debounce_events_t events;
+        debounce_get_events(&events);
+
+        if (events.pressed || events.released || events.held)
+        {
+            printf("pressed 0x%08lx released 0x%08lx held 0x%08lx state 0x%08lx\n",
+                   events.pressed, events.released, events.held, debounce_get_state());
+        }
+
+        sleep(10);
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    seventeen_with_library();
+}
@@ -0,0 +1,97 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 6 (Onboard Temperature)
+
+/* Choose 'C' for Celsius or 'F' for Fahrenheit. */
+#define TEMPERATURE_UNITS 'C'
+
+/* References for this implementation:
+ * raspberry-pi-pico-c-sdk.pdf, Section '4.1.1. hardware_adc'
+ * pico-examples/adc/adc_console/adc_console.c */
+float read_onboard_temperature(const char unit) 
+{
+    /* 12-bit conversion, assume max value == ADC_VREF == 3.3 V */
+    const float conversionFactor = 3.3f / (1 << 12);
+
+    float adc = (float)adc_read() * conversionFactor;
+    float tempC = 27.0f - (adc - 0.706f) / 0.001721f;
+
+    if (unit == 'C') 
+    {
+        return tempC;
+    } 
+    
+    else if (unit == 'F') 
+    {
+        return tempC * 9 / 5 + 32;
+    }
+
+    return -1.0f;
+}
+
+void six_without_library() 
+{
+    stdio_init_all();
+    #ifdef PICO_DEFAULT_LED_PIN
+        gpio_init(PICO_DEFAULT_LED_PIN);
+        gpio_set_dir(PICO_DEFAULT_LED_PIN, GPIO_OUT);
+    #endif
+
+    /* Initialize hardware AD converter, enable onboard temperature sensor and
+     *   select its channel (do this once for efficiency, but beware that this
+     *   is a global operation). */
+    adc_init();
+    adc_set_temp_sensor_enabled(true);
+    adc_select_input(4);
+
+    while (true) 
+    {
+        float temperature = read_onboard_temperature(TEMPERATURE_UNITS);
+        printf("Onboard temperature = %.02f %c\n", temperature, TEMPERATURE_UNITS);
+
+        #ifdef PICO_DEFAULT_LED_PIN
+            gpio_put(PICO_DEFAULT_LED_PIN, 1);
+            sleep_ms(10);
+
+            gpio_put(PICO_DEFAULT_LED_PIN, 0);
+        #endif
+
+        sleep_ms(990);
+    }
+}
+
+void six_with_library() 
+{
+    stdio_init_all();
+
+    #ifdef PICO_DEFAULT_LED_PIN
+        gpio_pin_init(PICO_DEFAULT_LED_PIN);
+        gpio_pin_set_mode(PICO_DEFAULT_LED_PIN, GPIO_OUT);
+    #endif
+
+    while (true) 
+    {
+        float temperature = acd_read_onboard_temperature(CELCIUS, 4);
+        printf("Onboard temperature = %.02f %c\n", temperature, TEMPERATURE_UNITS);
+
+        #ifdef PICO_DEFAULT_LED_PIN
+            gpio_pin_set_high_low(PICO_DEFAULT_LED_PIN, 1);
+            sleep(10);
+
+            gpio_pin_set_high_low(PICO_DEFAULT_LED_PIN, 0);
+        #endif
+
+        sleep(990);
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    #ifdef EXAMPLE_WITHOUT_LIBRARY
+        six_without_library();
+    #else
+        six_with_library();
+    #endif
+}
@@ -0,0 +1,87 @@
+#include "PicoLibrary.h"
+#include "hardware/pwm.h"
+
+#pragma region Example 16 (Edge Capture)
+
+// Connect these two pins with a jumper wire, as for the PWM test in main.
+#define EDGE_OUTPUT_PIN 2
+#define EDGE_MEASURE_PIN 5
+#define EDGE_WINDOW_MS 200
+
+const uint32_t edge_test_frequencies[] =
+{
+    1000,
+    10000,
+    20000,
+    50000,
+    100000,
+    150000,
+    200000,
+    300000,
+    500000
+};
+
+void sixteen_with_library()
+{
+    stdio_init_all();
+    printf("\nEdge capture rate test\n");
+
+    // Count at 1 MHz so the wrap value is the period in microseconds.
+    pwm_config cfg = pwm_get_default_config();
+    pwm_config_set_clkdiv(&cfg, clock_get_hz(clk_sys) / 1000000.0f);
+    pwm_init(pwm_gpio_to_slice_num(EDGE_OUTPUT_PIN), &cfg, false);
+    gpio_set_function(EDGE_OUTPUT_PIN, GPIO_FUNC_PWM);
+
+    gpio_pin_init(EDGE_MEASURE_PIN);
+    edge_capture_start(1u << EDGE_MEASURE_PIN);
+
+    uint32_t highest_clean_rate = 0;
+
+    for (uint i = 0; i < count_of(edge_test_frequencies); ++i)
+    {
+        uint32_t frequency = edge_test_frequencies[i];
+        uint slice = pwm_gpio_to_slice_num(EDGE_OUTPUT_PIN);
+        uint16_t wrap = 1000000 / frequency - 1;
+
+        // Above 500 kHz the 1 MHz count leaves no room for a high and a low phase.
+        pwm_set_wrap(slice, wrap);
+        pwm_set_gpio_level(EDGE_OUTPUT_PIN, (wrap + 1) / 2);
+
+        edge_capture_stop();
+        edge_capture_start(1u << EDGE_MEASURE_PIN);
+        pwm_set_enabled(slice, true);
+
+        absolute_time_t end = make_timeout_time_ms(EDGE_WINDOW_MS);
+        size_t edges = 0;
+
+        while (!time_reached(end))
+        {
+            edges += edge_capture_process();
+        }
+
+        pwm_set_enabled(slice, false);
+        edges += edge_capture_process();
+
+        uint32_t overruns = edge_capture_overruns();
+        uint32_t missed = edge_capture_missed();
+        uint32_t edge_rate = edges * 1000 / EDGE_WINDOW_MS;
+        printf("%6lu Hz: %7lu edges/s captured, %lu overruns, %lu missed, measured %.1f Hz, duty %.1f%%\n",
+               frequency, edge_rate, overruns, missed,
+               edge_capture_frequency(EDGE_MEASURE_PIN), edge_capture_duty_cycle(EDGE_MEASURE_PIN) * 100.f);
+
+        if (overruns == 0 && missed == 0 && edge_rate >= frequency * 2 * 99 / 100)
+        {
+            highest_clean_rate = frequency * 2;
+        }
+    }
+
+    edge_capture_stop();
+    printf("Highest edge rate without lost events: %lu edges/s\n", highest_clean_rate);
+}
+
+#pragma endregion
+
+int main()
+{
+    sixteen_with_library();
+}
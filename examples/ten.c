@@ -0,0 +1,103 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 10 (Hello Anything)
+
+void ten_without_library() 
+{
+    // create feature groups to group configuration settings
+    // these will also show up in picotool info, not just picotool config
+    bi_decl(bi_program_feature_group(0x1111, 0, "UART Configuration"));
+    bi_decl(bi_program_feature_group(0x1111, 1, "Enabled Interfaces"));
+    // stdio_uart configuration and initialisation
+    bi_decl(bi_ptr_int32(0x1111, 1, use_uart, 1));
+    bi_decl(bi_ptr_int32(0x1111, 0, uart_num, 0));
+    bi_decl(bi_ptr_int32(0x1111, 0, uart_tx, 0));
+    bi_decl(bi_ptr_int32(0x1111, 0, uart_rx, 1));
+    bi_decl(bi_ptr_int32(0x1111, 0, uart_baud, 115200));
+
+    // if (use_uart) 
+    // {
+    //     stdio_uart_init_full(UART_INSTANCE(uart_num), uart_baud, uart_tx, uart_rx);
+    // }
+
+    // stdio_usb initialisation
+    bi_decl(bi_ptr_int32(0x1111, 1, use_usb, 1));
+
+    if (use_usb) 
+    {
+        stdio_usb_init();
+    }
+
+    // default printed string
+    bi_decl(bi_ptr_string(0, 0, text, "Hello, world!", 256));
+
+    while (true) 
+    {
+        printf("%s\n", text);
+        sleep_ms(1000);
+    }
+}
+
+void ten_with_library() 
+{
+    // create feature groups to group configuration settings
+    // these will also show up in picotool info, not just picotool config
+    binary_info_name_group(0x1111, 0, "UART Configuration");
+    binary_info_name_group(0x1111, 1, "Enabled Interfaces");
+    // stdio_uart configuration and initialisation
+    binary_define_variable_int32(0x1111, 1, use_uart, 1);
+    binary_define_variable_int32(0x1111, 0, uart_num, 0);
+    binary_define_variable_int32(0x1111, 0, uart_tx, 0);
+    binary_define_variable_int32(0x1111, 0, uart_rx, 1);
+    binary_define_variable_int32(0x1111, 0, uart_baud, 115200);
+
+    // UART output through the DMA rings rather than blocking stdio
+    if (use_uart) 
+    {
+        hard_assert(uart_dma_init(uart_num, uart_tx, uart_rx, uart_baud) == PICO_OK);
+    }
+
+    // stdio_usb initialisation
+    binary_define_variable_int32(0x1111, 1, use_usb, 1);
+    
+    if (use_usb) 
+    {
+        stdio_usb_init();
+    }
+
+    // default printed string
+    binary_define_variable_string(0, 0, text, "Hello, world!", 256);
+
+    while (true) 
+    {
+        printf("%s\n", text);
+
+        if (use_uart)
+        {
+            uart_dma_write(text, strlen(text));
+            uart_dma_write("\r\n", 2);
+
+            // Echo back whatever arrived in the meantime.
+            char received[64];
+            size_t count;
+
+            while ((count = uart_dma_read(received, sizeof(received))) > 0)
+            {
+                uart_dma_write(received, count);
+            }
+        }
+
+        sleep(1000);
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    #ifdef EXAMPLE_WITHOUT_LIBRARY
+        ten_without_library();
+    #else
+        ten_with_library();
+    #endif
+}
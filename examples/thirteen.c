@@ -0,0 +1,69 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 13 (Fast Path Timing)
+
+#define FAST_PATH_PIN 15
+#define FAST_PATH_TOGGLES 1000
+
+void thirteen_without_library()
+{
+    stdio_init_all();
+    gpio_init(FAST_PATH_PIN);
+    gpio_set_dir(FAST_PATH_PIN, GPIO_OUT);
+    cycle_counter_start();
+
+    while (true)
+    {
+        uint32_t start = cycle_counter_get();
+
+        for (int i = 0; i < FAST_PATH_TOGGLES; i++)
+        {
+            gpio_put(FAST_PATH_PIN, true);
+            gpio_put(FAST_PATH_PIN, false);
+        }
+
+        uint32_t cycles = cycle_counter_elapsed(start);
+        printf("gpio_put: %lu cycles for %d toggles\n", cycles, FAST_PATH_TOGGLES * 2);
+        sleep_ms(1000);
+    }
+}
+
+void thirteen_with_library()
+{
+    stdio_init_all();
+    gpio_pin_init(FAST_PATH_PIN);
+    gpio_set_dir(FAST_PATH_PIN, GPIO_OUT);
+    cycle_counter_start();
+
+    #ifdef PICO_LIBRARY_INLINE
+        const string mode = "inline";
+    #else
+        const string mode = "lazy";
+    #endif
+
+    while (true)
+    {
+        uint32_t start = cycle_counter_get();
+
+        for (int i = 0; i < FAST_PATH_TOGGLES; i++)
+        {
+            gpio_pin_set_high_low(FAST_PATH_PIN, true);
+            gpio_pin_set_high_low(FAST_PATH_PIN, false);
+        }
+
+        uint32_t cycles = cycle_counter_elapsed(start);
+        printf("gpio_pin_set_high_low (%s): %lu cycles for %d toggles\n", mode, cycles, FAST_PATH_TOGGLES * 2);
+        sleep(1000);
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    #ifdef EXAMPLE_WITHOUT_LIBRARY
+        thirteen_without_library();
+    #else
+        thirteen_with_library();
+    #endif
+}
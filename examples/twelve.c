@@ -0,0 +1,48 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 12 (Hello GP Out)
+
+void twelve_without_library()
+{
+    stdio_init_all();
+    printf("Hello gpout\n");
+
+    // Output clk_sys / 10 to gpio 21, etc...
+    clock_gpio_init(21, CLOCKS_CLK_GPOUT0_CTRL_AUXSRC_VALUE_CLK_SYS, 10);
+    clock_gpio_init(23, CLOCKS_CLK_GPOUT1_CTRL_AUXSRC_VALUE_CLK_USB, 10);
+    clock_gpio_init(24, CLOCKS_CLK_GPOUT2_CTRL_AUXSRC_VALUE_CLK_ADC, 10);
+    
+    #if PICO_RP2040
+        clock_gpio_init(25, CLOCKS_CLK_GPOUT3_CTRL_AUXSRC_VALUE_CLK_RTC, 10);
+    #else
+        clock_gpio_init(25, CLOCKS_CLK_GPOUT3_CTRL_AUXSRC_VALUE_CLK_PERI, 10);
+    #endif
+}
+
+void twelve_with_library()
+{
+    stdio_init_all();
+    printf("Hello gpout\n");
+
+    // Output clk_sys / 10 to gpio 21, etc...
+    gpio_pin_underclock(21, 10, CLOCKS_CLK_GPOUT0_CTRL_AUXSRC_VALUE_CLK_SYS);
+    gpio_pin_underclock(23, 10, CLOCKS_CLK_GPOUT1_CTRL_AUXSRC_VALUE_CLK_USB);
+    gpio_pin_underclock(24, 10, CLOCKS_CLK_GPOUT2_CTRL_AUXSRC_VALUE_CLK_ADC);
+    
+    #if PICO_RP2040
+        gpio_pin_underclock(25, 10, CLOCKS_CLK_GPOUT3_CTRL_AUXSRC_VALUE_CLK_RTC);
+    #else
+        gpio_pin_underclock(25, 10, CLOCKS_CLK_GPOUT3_CTRL_AUXSRC_VALUE_CLK_PERI);
+    #endif
+}
+
+#pragma endregion
+
+int main()
+{
+    #ifdef EXAMPLE_WITHOUT_LIBRARY
+        twelve_without_library();
+    #else
+        twelve_with_library();
+    #endif
+}
@@ -0,0 +1,52 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 20 (Boot Profile)
+
+// Samples straight after reset while USB enumerates, everything printed before the host
+// opens the port is buffered and shows up once it does.
+#define BOOT_ADC_INPUT 0
+#define BOOT_SAMPLES 1000
+
+uint16_t boot_samples[BOOT_SAMPLES];
+
+void twenty_with_library()
+{
+    stdio_lazy_init();
+    printf("\nBoot profile\n");
+
+    adc_input_init(BOOT_ADC_INPUT);
+    adc_select_pin(BOOT_ADC_INPUT);
+    boot_mark("adc init");
+
+    uint16_t first = adc_read_selected_raw();
+    boot_mark("first sample");
+
+    adc_capture(boot_samples, BOOT_SAMPLES);
+    boot_mark("first block");
+
+    printf("First sample 0x%03x\n", first);
+    boot_report();
+
+    while (true)
+    {
+        adc_capture(boot_samples, BOOT_SAMPLES);
+
+        uint32_t sum = 0;
+
+        for (int i = 0; i < BOOT_SAMPLES; i++)
+        {
+            sum += boot_samples[i];
+        }
+
+        printf("Mean 0x%03lx, USB %s, %lu bytes dropped before it connected\n",
+               sum / BOOT_SAMPLES, stdio_lazy_is_connected() ? "connected" : "waiting", stdio_lazy_dropped());
+        sleep(1000);
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    twenty_with_library();
+}
@@ -0,0 +1,82 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 28 (Compression)
+
+// Compresses real captures, ADC0 and the temperature sensor, with each predictor on core1,
+// where it would run next to a stream. Prints the size against uint16_t and packed samples
+// and the cycles a sample, which at 500 ksps and 125 MHz has to stay under 250, then checks
+// the block decodes back to the capture.
+#define COMPRESS_SAMPLES 4096
+#define COMPRESS_BUDGET_CYCLES (125000000 / 500000)
+
+uint16_t compress_trace[COMPRESS_SAMPLES] __aligned(4);
+uint16_t compress_decoded[COMPRESS_SAMPLES] __aligned(4);
+uint8_t compress_block[RICE_MAX_BYTES(COMPRESS_SAMPLES)] __aligned(4);
+
+void twentyeight_core1_entry()
+{
+    cycle_counter_start();
+
+    while (true)
+    {
+        const char * name = (const char *) multicore_fifo_pop_blocking();
+        printf("%s, %u samples: %u bytes as uint16_t, %u packed\n",
+               name, COMPRESS_SAMPLES, sizeof(compress_trace), PACK12_BYTES(COMPRESS_SAMPLES));
+
+        for (uint8_t order = 0; order <= 2; order++)
+        {
+            uint32_t start = cycle_counter_get();
+            size_t size = rice_encode_block(compress_trace, COMPRESS_SAMPLES, order, compress_block);
+            uint32_t encode_cycles = cycle_counter_elapsed(start);
+
+            start = cycle_counter_get();
+            int count = rice_decode_block(compress_block, size, compress_decoded, COMPRESS_SAMPLES);
+            uint32_t decode_cycles = cycle_counter_elapsed(start);
+
+            bool is_equal = count == COMPRESS_SAMPLES;
+
+            for (size_t i = 0; is_equal && i < COMPRESS_SAMPLES; i++)
+            {
+                is_equal = compress_decoded[i] == (compress_trace[i] & 0xfff);
+            }
+
+            float encode_per_sample = (float) encode_cycles / COMPRESS_SAMPLES;
+            printf("  order %u: %u bytes, %.2fx uint16_t, %.2fx packed, encode %.1f cycles/sample (%s), decode %.1f, round trip %s\n",
+                   order, size, (float) sizeof(compress_trace) / size, (float) PACK12_BYTES(COMPRESS_SAMPLES) / size,
+                   encode_per_sample, encode_per_sample < COMPRESS_BUDGET_CYCLES ? "keeps up" : "too slow",
+                   (float) decode_cycles / COMPRESS_SAMPLES, is_equal ? "matches" : "differs");
+        }
+
+        multicore_fifo_push_blocking(0);
+    }
+}
+
+void twentyeight_with_library()
+{
+    stdio_init_all();
+    adc_input_init(0);
+    adc_set_temperature_sensor(true);
+    multicore_launch_core1(twentyeight_core1_entry);
+
+    while (true)
+    {
+        adc_select_pin(0);
+        adc_capture(compress_trace, COMPRESS_SAMPLES);
+        multicore_fifo_push_blocking((uint32_t) "ADC0");
+        multicore_fifo_pop_blocking();
+
+        adc_select_pin(4);
+        adc_capture(compress_trace, COMPRESS_SAMPLES);
+        multicore_fifo_push_blocking((uint32_t) "Temperature sensor");
+        multicore_fifo_pop_blocking();
+
+        sleep(2000);
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    twentyeight_with_library();
+}
@@ -0,0 +1,47 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 25 (Frequency Counter)
+
+// clk_sys divided down on GPOUT0, GPIO 21, and measured on GPIN0, GPIO 20, so jumper the
+// two. Each divider is counted both ways, and the last one also without blocking while
+// this core counts loops.
+#define COUNTER_OUTPUT_PIN 21
+#define COUNTER_GATE_US 1000000
+
+const float counter_dividers[] = {1250.0f, 125000.0f, 2500000.0f};
+
+void twentyfive_with_library()
+{
+    stdio_init_all();
+
+    for (uint8_t i = 0; i < count_of(counter_dividers); i++)
+    {
+        gpio_pin_underclock(COUNTER_OUTPUT_PIN, counter_dividers[i], CLOCKS_CLK_GPOUT0_CTRL_AUXSRC_VALUE_CLK_SYS);
+        double expected = clock_get_hz(clk_sys) / counter_dividers[i];
+
+        double direct = freq_counter_measure(FREQ_COUNTER_GPIN0_PIN, COUNTER_GATE_US, FREQ_COUNTER_DIRECT);
+        double reciprocal = freq_counter_measure(FREQ_COUNTER_GPIN0_PIN, COUNTER_GATE_US, FREQ_COUNTER_RECIPROCAL);
+        printf("%.3f Hz: direct %.3f Hz, reciprocal %.3f Hz\n", expected, direct, reciprocal);
+    }
+
+    freq_counter_result_t result;
+    uint32_t loops = 0;
+
+    freq_counter_start(FREQ_COUNTER_GPIN0_PIN, COUNTER_GATE_US, FREQ_COUNTER_AUTO);
+
+    while (freq_counter_get_result(&result) == PICO_ERROR_NO_DATA)
+    {
+        loops++;
+    }
+
+    printf("%s: %.3f Hz from %lu samples in %lu us, %lu loops meanwhile\n",
+           result.mode == FREQ_COUNTER_RECIPROCAL ? "Reciprocal" : "Direct", result.hz, result.samples, result.gate_us, loops);
+    freq_counter_cancel();
+}
+
+#pragma endregion
+
+int main()
+{
+    twentyfive_with_library();
+}
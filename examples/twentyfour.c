@@ -0,0 +1,74 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 24 (Audio Playback)
+
+// A test tone, then a loop of whatever is on ADC 0 played back. Put a 1 kΩ resistor and
+// 100 nF capacitor to ground on GPIO 16 to filter the PWM, and take the audio from the
+// capacitor.
+#define PLAYBACK_PIN 16
+#define PLAYBACK_RATE 22050
+#define PLAYBACK_TONE_COUNT 441 // 8 cycles make 400 Hz
+#define PLAYBACK_CAPTURE_COUNT 22050
+
+int16_t playback_tone[PLAYBACK_TONE_COUNT];
+uint16_t playback_capture[PLAYBACK_CAPTURE_COUNT];
+
+void twentyfour_with_library()
+{
+    stdio_init_all();
+
+    int result = audio_out_start(PLAYBACK_PIN, PLAYBACK_RATE);
+
+    if (result != PICO_OK)
+    {
+        printf("audio_out_start failed: %d\n", result);
+        return;
+    }
+
+    audio_out_stats_t stats;
+    audio_out_get_stats(&stats);
+    printf("Playing at %lu Hz on GPIO %d\n", stats.sample_rate, PLAYBACK_PIN);
+
+    audio_out_fill_sine(playback_tone, PLAYBACK_TONE_COUNT, 8, 16384);
+    audio_out_play(playback_tone, PLAYBACK_TONE_COUNT, PLAYBACK_RATE, true);
+    sleep(2000);
+
+    // Fading out a step at a time shows the volume taking effect between blocks.
+    for (int volume = AUDIO_OUT_VOLUME_MAX; volume > 0; volume -= 1024)
+    {
+        audio_out_set_volume(volume);
+        sleep(20);
+    }
+
+    audio_out_play(NULL, 0, PLAYBACK_RATE, false);
+    audio_out_set_volume(AUDIO_OUT_VOLUME_MAX);
+
+    // One second from ADC 0 at the playback rate, then played back at that rate in a loop.
+    adc_input_init(0);
+    adc_select_input(0);
+    adc_set_clkdiv(48000000.0f / PLAYBACK_RATE - 1);
+
+    while (true)
+    {
+        printf("Recording\n");
+        adc_capture(playback_capture, PLAYBACK_CAPTURE_COUNT);
+
+        printf("Playing back\n");
+        audio_out_play_adc(playback_capture, PLAYBACK_CAPTURE_COUNT, PLAYBACK_RATE, false);
+
+        while (audio_out_is_playing())
+        {
+            tight_loop_contents();
+        }
+
+        audio_out_get_stats(&stats);
+        printf("%lu blocks, %lu us to render the last\n", stats.blocks, stats.render_us);
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    twentyfour_with_library();
+}
@@ -0,0 +1,56 @@
+#include "PicoLibrary.hpp"
+#include <stdio.h>
+
+#pragma region Example 29 (Compile-Time Pins)
+
+// PicoLibrary.hpp's pins and channels, checked when this file compiles. The LED blinks
+// faster as GPIO 26 rises and a PWM output on GPIO 15 follows it, with the temperature
+// sensor read on the same ADC every second.
+using Led = pico_library::Pin<25>;
+using Knob = pico_library::AdcPin<26>; // Same as AdcChannel<0>
+using Dimmer = pico_library::PwmOutput<15>;
+using Temperature = pico_library::TemperatureSensor;
+
+static_assert(Knob::input == 0 && Knob::pin == 26, "AdcPin<26> is ADC input 0");
+static_assert(Dimmer::slice == 7 && Dimmer::channel == 1, "GPIO 15 is PWM 7B");
+static_assert(Led::mask == 1u << 25, "GPIO 25's SIO bit");
+
+// Each of these fails the build with the message in its comment.
+#if 0
+    static_assert(pico_library::Pin<30>::number == 30);     // Pin: the RP2040 only has GPIO 0 to 29
+    static_assert(pico_library::AdcPin<25>::input == 0);    // AdcPin: only GPIO 26 to 29 are connected to the ADC
+    static_assert(pico_library::PwmInput<4>::slice == 2);   // PwmInput: only the PWM B pins (odd GPIOs) can be used as inputs
+#endif
+
+void twentynine_with_library()
+{
+    stdio_init_all();
+
+    Led::init_output();
+    Knob::init();
+    Temperature::init();
+    Dimmer::init(4095);
+
+    absolute_time_t next_report = make_timeout_time_ms(1000);
+
+    while (true)
+    {
+        uint16_t level = Knob::read_raw();
+        Dimmer::set_level(level);
+        Led::toggle();
+        sleep_ms(50 + (4095 - level) / 10);
+
+        if (time_reached(next_report))
+        {
+            printf("Knob %.2f V, sensor %.3f V\n", Knob::read_volts(), Temperature::read_volts());
+            next_report = make_timeout_time_ms(1000);
+        }
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    twentynine_with_library();
+}
@@ -0,0 +1,79 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 21 (ADC Resolution)
+
+// Oversampled reads at every resolution from the same input. With a steady voltage on the
+// pin, the noise shows how many of the extra bits are real.
+#define RESOLUTION_ADC_INPUT 0
+#define RESOLUTION_SAMPLE_RATE 500000
+#define RESOLUTION_OUTPUTS 256
+
+uint16_t resolution_output[RESOLUTION_OUTPUTS];
+uint16_t resolution_kernel_output[ADC_OVERSAMPLE_BLOCK]; // A whole block's outputs at 12 bits
+uint16_t resolution_raw[ADC_OVERSAMPLE_BLOCK] __aligned(4);
+
+void twentyone_with_library()
+{
+    stdio_init_all();
+    adc_input_init(RESOLUTION_ADC_INPUT);
+    adc_select_pin(RESOLUTION_ADC_INPUT);
+    cycle_counter_start();
+
+    while (true)
+    {
+        printf("\nBits  Output rate  Mean       RMS noise  ENOB   Cycles/sample  Read time\n");
+
+        for (uint8_t bits = 12; bits <= ADC_OVERSAMPLE_MAX_BITS; bits++)
+        {
+            uint32_t samples = 1u << (2 * (bits - 12));
+            uint64_t start = time_us_64();
+            int result = adc_oversample_read_block(RESOLUTION_ADC_INPUT, bits, RESOLUTION_SAMPLE_RATE, resolution_output, RESOLUTION_OUTPUTS);
+            uint64_t elapsed = time_us_64() - start;
+
+            if (result != PICO_OK)
+            {
+                printf("%4u  read failed: %d\n", bits, result);
+                continue;
+            }
+
+            uint32_t sum = 0;
+
+            for (int i = 0; i < RESOLUTION_OUTPUTS; i++)
+            {
+                sum += resolution_output[i];
+            }
+
+            float mean = (float) sum / RESOLUTION_OUTPUTS;
+            float sum_of_squares = 0;
+
+            for (int i = 0; i < RESOLUTION_OUTPUTS; i++)
+            {
+                float difference = resolution_output[i] - mean;
+                sum_of_squares += difference * difference;
+            }
+
+            // Both on the 16-bit scale, an ideal N-bit converter has 2^(16 - N) / sqrt(12) LSB of noise.
+            float rms = sqrtf(sum_of_squares / RESOLUTION_OUTPUTS);
+            float enob = rms > 0 ? log2f(65536.0f / (rms * sqrtf(12))) : 16;
+
+            // The kernel on its own, over a block of 12-bit samples.
+            adc_capture(resolution_raw, ADC_OVERSAMPLE_BLOCK);
+            uint32_t cycles_start = cycle_counter_get();
+            adc_oversample_decimate_block(resolution_raw, resolution_kernel_output, ADC_OVERSAMPLE_BLOCK / samples, bits, RESOLUTION_ADC_INPUT);
+            uint32_t cycles = cycle_counter_elapsed(cycles_start);
+
+            printf("%4u  %7lu sps  %6.4f V  %6.2f LSB  %5.2f  %13.2f  %6llu us\n",
+                   bits, RESOLUTION_SAMPLE_RATE / samples, adc_oversample_volts(mean), rms, enob,
+                   (float) cycles / ADC_OVERSAMPLE_BLOCK, elapsed);
+        }
+
+        sleep(2000);
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    twentyone_with_library();
+}
@@ -0,0 +1,66 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 27 (Packed Samples)
+
+// Cycles a sample to pack and unpack a capture, word at a time against byte at a time,
+// and the bytes saved. The byte path is forced by packing one byte off a word boundary.
+#define PACKED_SAMPLES 2048
+
+uint16_t packed_raw[PACKED_SAMPLES] __aligned(4);
+uint16_t packed_unpacked[PACKED_SAMPLES] __aligned(4);
+uint8_t packed_bytes[PACK12_BYTES(PACKED_SAMPLES) + 4] __aligned(4);
+uint8_t packed_capture[PACK12_BYTES(PACKED_SAMPLES)] __aligned(4);
+
+void twentyseven_with_library()
+{
+    stdio_init_all();
+    adc_input_init(0);
+    adc_select_pin(0);
+    cycle_counter_start();
+
+    while (true)
+    {
+        adc_capture(packed_raw, PACKED_SAMPLES);
+
+        uint32_t start = cycle_counter_get();
+        size_t packed_size = pack12_block(packed_raw, packed_bytes, PACKED_SAMPLES);
+        uint32_t pack_cycles = cycle_counter_elapsed(start);
+
+        start = cycle_counter_get();
+        unpack12_block(packed_bytes, packed_unpacked, PACKED_SAMPLES);
+        uint32_t unpack_cycles = cycle_counter_elapsed(start);
+        bool is_word_equal = memcmp(packed_raw, packed_unpacked, sizeof(packed_raw)) == 0;
+
+        start = cycle_counter_get();
+        pack12_block(packed_raw, packed_bytes + 1, PACKED_SAMPLES);
+        uint32_t pack_byte_cycles = cycle_counter_elapsed(start);
+
+        start = cycle_counter_get();
+        unpack12_block(packed_bytes + 1, packed_unpacked, PACKED_SAMPLES);
+        uint32_t unpack_byte_cycles = cycle_counter_elapsed(start);
+        bool is_byte_equal = memcmp(packed_raw, packed_unpacked, sizeof(packed_raw)) == 0;
+
+        printf("%u samples: %u bytes as uint16_t, %u packed, %u saved (%.0f%%), round trip %s by words, %s by bytes\n",
+               PACKED_SAMPLES, sizeof(packed_raw), packed_size, sizeof(packed_raw) - packed_size,
+               100.0f * (sizeof(packed_raw) - packed_size) / sizeof(packed_raw),
+               is_word_equal ? "matches" : "differs", is_byte_equal ? "matches" : "differs");
+        printf("  pack   %.2f cycles/sample by words, %.2f by bytes\n",
+               (float) pack_cycles / PACKED_SAMPLES, (float) pack_byte_cycles / PACKED_SAMPLES);
+        printf("  unpack %.2f cycles/sample by words, %.2f by bytes\n",
+               (float) unpack_cycles / PACKED_SAMPLES, (float) unpack_byte_cycles / PACKED_SAMPLES);
+
+        // Capturing straight to the packed form never needs the uint16_t buffer.
+        adc_capture_packed(packed_capture, PACKED_SAMPLES);
+        unpack12_block(packed_capture, packed_unpacked, 4);
+        printf("  packed capture starts %03x %03x %03x %03x\n", packed_unpacked[0], packed_unpacked[1], packed_unpacked[2], packed_unpacked[3]);
+
+        sleep(2000);
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    twentyseven_with_library();
+}
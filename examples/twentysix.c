@@ -0,0 +1,83 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 26 (Shared Buffers)
+
+// Capture, processing and sending share one pool of blocks. Core0 captures a block, passes
+// it to core1 to work out its mean and peak, and sends the first few samples itself, so
+// the block has two holders and goes back to the pool after whichever finishes last.
+#define SHARED_BLOCK_SAMPLES 512
+#define SHARED_BLOCK_COUNT 8
+#define SHARED_ARENA_SIZE (SHARED_BLOCK_COUNT * SHARED_BLOCK_SAMPLES * 2 + 64)
+
+BLOCK_ARENA_MEMORY(shared_arena_memory, SHARED_ARENA_SIZE);
+block_arena_t shared_arena;
+block_pool_t shared_pool;
+
+void twentysix_core1_entry()
+{
+    while (true)
+    {
+        uint16_t * samples = (uint16_t *) multicore_fifo_pop_blocking();
+        uint32_t sum = 0;
+        uint16_t peak = 0;
+
+        for (size_t i = 0; i < SHARED_BLOCK_SAMPLES; i++)
+        {
+            sum += samples[i];
+            peak = samples[i] > peak ? samples[i] : peak;
+        }
+
+        printf("Mean %lu, peak %u\n", sum / SHARED_BLOCK_SAMPLES, peak);
+        block_pool_release(&shared_pool, samples);
+    }
+}
+
+void twentysix_with_library()
+{
+    stdio_init_all();
+    adc_input_init(0);
+    adc_select_input(0);
+
+    block_arena_init(&shared_arena, shared_arena_memory, SHARED_ARENA_SIZE);
+
+    if (block_pool_init(&shared_pool, &shared_arena, SHARED_BLOCK_SAMPLES * sizeof(uint16_t), SHARED_BLOCK_COUNT, BLOCK_POOL_MIN_ALIGN) != PICO_OK)
+    {
+        printf("block_pool_init failed\n");
+        return;
+    }
+
+    multicore_launch_core1(twentysix_core1_entry);
+    block_pool_stats_t stats;
+
+    while (true)
+    {
+        uint16_t * samples = block_pool_alloc(&shared_pool);
+
+        if (samples == NULL)
+        {
+            sleep(10);
+            continue;
+        }
+
+        adc_capture(samples, SHARED_BLOCK_SAMPLES);
+
+        // One reference for core1, one kept for sending.
+        block_pool_retain(&shared_pool, samples);
+        multicore_fifo_push_blocking((uint32_t) samples);
+
+        printf("Sent %03x %03x %03x %03x\n", samples[0], samples[1], samples[2], samples[3]);
+        block_pool_release(&shared_pool, samples);
+
+        block_pool_get_stats(&shared_pool, &stats);
+        printf("%u of %u blocks in use, at most %u, %lu failures, arena %u of %u bytes\n",
+               stats.in_use, stats.block_count, stats.high_water, stats.failures, shared_arena.high_water, shared_arena.size);
+        sleep(500);
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    twentysix_with_library();
+}
@@ -0,0 +1,66 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 23 (PWM Waveforms)
+
+// Three breaths, then two quick blinks, looping, while the CPU only counts. Uses the
+// Pico's LED, or GPIO 15 on boards where the LED is not a GPIO.
+#if defined(PICO_DEFAULT_LED_PIN)
+    #define WAVE_PIN PICO_DEFAULT_LED_PIN
+#else
+    #define WAVE_PIN 15
+#endif
+
+#define WAVE_WRAP 999
+#define WAVE_STEP_HZ 1000 // PWM frequency too, fast enough not to flicker
+#define WAVE_BREATHE_STEPS 2000
+#define WAVE_BLINK_STEPS 250
+
+uint16_t wave_breathe[WAVE_BREATHE_STEPS];
+uint16_t wave_blink[WAVE_BLINK_STEPS];
+
+void twentythree_with_library()
+{
+    stdio_init_all();
+
+    pwm_wave_fill_breathe(wave_breathe, WAVE_BREATHE_STEPS, WAVE_WRAP);
+    pwm_wave_fill_blink(wave_blink, WAVE_BLINK_STEPS, WAVE_WRAP, 0.4f);
+
+    const pwm_wave_segment_t pattern[] =
+    {
+        {WAVE_BREATHE_STEPS, wave_breathe},
+        {WAVE_BREATHE_STEPS, wave_breathe},
+        {WAVE_BREATHE_STEPS, wave_breathe},
+        {WAVE_BLINK_STEPS, wave_blink},
+        {WAVE_BLINK_STEPS, wave_blink}
+    };
+
+    int result = pwm_wave_start(WAVE_PIN, WAVE_WRAP, WAVE_STEP_HZ, pattern, count_of(pattern), true);
+
+    if (result != PICO_OK)
+    {
+        printf("pwm_wave_start failed: %d\n", result);
+        return;
+    }
+
+    uint32_t idle_loops = 0;
+    uint64_t last_report = time_us_64();
+
+    while (pwm_wave_is_running(WAVE_PIN))
+    {
+        idle_loops++;
+
+        if (time_us_64() - last_report >= 1000000)
+        {
+            printf("Pattern on GPIO %d, CPU free for %lu loops in the last second\n", WAVE_PIN, idle_loops);
+            idle_loops = 0;
+            last_report += 1000000;
+        }
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    twentythree_with_library();
+}
@@ -0,0 +1,65 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 22 (UDP Telemetry)
+
+// Three ADC inputs, VSYS and temperature every TELEMETRY_INTERVAL_MS, which fills a packet
+// about every 480 ms, so the flush time sends one every TELEMETRY_FLUSH_MS instead. On the
+// host, nc -ul 4950 | xxd shows the packets arriving.
+#ifndef WIFI_SSID
+    #define WIFI_SSID ""
+    #define WIFI_PASSWORD ""
+#endif
+
+#ifndef TELEMETRY_HOST
+    #define TELEMETRY_HOST "192.168.1.2"
+#endif
+
+#define TELEMETRY_INTERVAL_MS 10
+#define TELEMETRY_FLUSH_MS 250
+
+void twentytwo_with_library()
+{
+    stdio_init_all();
+
+    if (telemetry_wifi_connect(WIFI_SSID, WIFI_PASSWORD, 30000) != PICO_OK)
+    {
+        printf("Could not connect to %s\n", WIFI_SSID);
+        return;
+    }
+
+    if (telemetry_udp_open(TELEMETRY_HOST, TELEMETRY_DEFAULT_PORT, TELEMETRY_FLUSH_MS) != PICO_OK)
+    {
+        printf("Could not open UDP to %s\n", TELEMETRY_HOST);
+        return;
+    }
+
+    printf("Sending telemetry to %s:%u\n", TELEMETRY_HOST, TELEMETRY_DEFAULT_PORT);
+
+    telemetry_stats_t stats;
+    uint32_t last_report = to_ms_since_boot(get_absolute_time());
+
+    while (true)
+    {
+        telemetry_add_readings(0x7);
+        telemetry_poll();
+
+        uint32_t now = to_ms_since_boot(get_absolute_time());
+
+        if (now - last_report >= 1000)
+        {
+            telemetry_get_stats(&stats);
+            printf("%lu records, %lu packets (%.1f/s), %lu dropped, %lu bytes\n",
+                   stats.records, stats.packets_sent, stats.packets_per_second, stats.packets_dropped, stats.bytes_sent);
+            last_report = now;
+        }
+
+        sleep(TELEMETRY_INTERVAL_MS);
+    }
+}
+
+#pragma endregion
+
+int main()
+{
+    twentytwo_with_library();
+}
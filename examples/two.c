@@ -0,0 +1,66 @@
+#include "PicoLibrary.h"
+
+#pragma region Example 2 (Blink)
+    #ifndef LED_DELAY_MS
+        #define LED_DELAY_MS 250
+    #endif
+
+    void two_without_library() 
+    {
+        #if defined(PICO_DEFAULT_LED_PIN)
+            // A device like Pico that uses a GPIO for the LED will define PICO_DEFAULT_LED_PIN
+            // so we can use normal GPIO functionality to turn the led on and off
+            gpio_init(PICO_DEFAULT_LED_PIN);
+            gpio_set_dir(PICO_DEFAULT_LED_PIN, GPIO_OUT);
+            hard_assert(PICO_OK == PICO_OK);
+        #elif defined(CYW43_WL_GPIO_LED_PIN)
+            // For Pico W devices we need to initialise the driver etc
+            hard_assert(cyw43_arch_init() == PICO_OK);
+        #endif
+
+        while (true) 
+        {
+            #if defined(PICO_DEFAULT_LED_PIN)
+                // Just set the GPIO on or off
+                gpio_put(PICO_DEFAULT_LED_PIN, true);
+            #elif defined(CYW43_WL_GPIO_LED_PIN)
+                // Ask the wifi "driver" to set the GPIO on or off
+                cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, true);
+            #endif
+
+            sleep_ms(LED_DELAY_MS);
+
+            #if defined(PICO_DEFAULT_LED_PIN)
+                // Just set the GPIO on or off
+                gpio_put(PICO_DEFAULT_LED_PIN, false);
+            #elif defined(CYW43_WL_GPIO_LED_PIN)
+                // Ask the wifi "driver" to set the GPIO on or off
+                cyw43_arch_gpio_put(CYW43_WL_GPIO_LED_PIN, false);
+            #endif
+
+            sleep_ms(LED_DELAY_MS);
+        }
+    }
+
+    void two_with_library() 
+    {
+        led_init();
+
+        while (true)
+        {
+            led_set(true);
+            sleep(LED_DELAY_MS);
+            led_set(false);
+            sleep(LED_DELAY_MS);
+        }
+    }
+#pragma endregion
+
+int main()
+{
+    #ifdef EXAMPLE_WITHOUT_LIBRARY
+        two_without_library();
+    #else
+        two_with_library();
+    #endif
+}
@@ -0,0 +1,75 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "src/rice.h"
+
+// Decodes a compressed usb_stream saved by usb_stream_receive -f into plain samples. Each
+// frame is a uint32 length and that many bytes, one rice_encode_block block possibly
+// followed by a padding byte, and its samples are written out as uint16 in order:
+//     rice_decode input output
+// A bad block stops the decode, with what came before it already written.
+
+int main(int argc, char ** argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "Usage: %s input output\n", argv[0]);
+        return 2;
+    }
+
+    FILE * input = fopen(argv[1], "rb");
+
+    if (input == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    FILE * output = fopen(argv[2], "wb");
+
+    if (output == NULL)
+    {
+        perror(argv[2]);
+        return 1;
+    }
+
+    static uint8_t block[RICE_MAX_BYTES(RICE_MAX_COUNT) + 1];
+    static uint16_t samples[RICE_MAX_COUNT];
+    uint32_t blocks = 0;
+    uint64_t sample_count = 0;
+    uint32_t length;
+    int result = PICO_OK;
+
+    while (result == PICO_OK && fread(&length, sizeof(length), 1, input) == 1)
+    {
+        if (length > sizeof(block) || fread(block, 1, length, input) != length)
+        {
+            fprintf(stderr, "Block %u: truncated or %u bytes long\n", blocks, length);
+            result = PICO_ERROR_INVALID_DATA;
+            break;
+        }
+
+        int count = rice_decode_block(block, length, samples, RICE_MAX_COUNT);
+
+        if (count < 0)
+        {
+            fprintf(stderr, "Block %u: error %d\n", blocks, count);
+            result = count;
+        }
+
+        else if (fwrite(samples, sizeof(uint16_t), count, output) != (size_t) count)
+        {
+            perror(argv[2]);
+            result = PICO_ERROR_IO;
+        }
+
+        else
+        {
+            blocks++;
+            sample_count += count;
+        }
+    }
+
+    fprintf(stderr, "%u blocks, %llu samples\n", blocks, (unsigned long long) sample_count);
+    fclose(input);
+    return fclose(output) != 0 || result != PICO_OK;
+}
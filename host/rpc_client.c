@@ -0,0 +1,259 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include "rpc_client.h"
+
+#pragma region RPC Client Functions
+
+int rpc_client_open(rpc_client_t * client, const char * path)
+{
+    int fd = open(path, O_RDWR | O_NOCTTY);
+
+    if (fd < 0)
+    {
+        return PICO_ERROR_IO;
+    }
+
+    // Raw, the frames are binary. The baud rate means nothing to USB CDC.
+    struct termios options;
+
+    if (tcgetattr(fd, &options) == 0)
+    {
+        cfmakeraw(&options);
+        tcsetattr(fd, TCSANOW, &options);
+        tcflush(fd, TCIOFLUSH);
+    }
+
+    rpc_client_attach(client, fd);
+    return PICO_OK;
+}
+
+void rpc_client_attach(rpc_client_t * client, int fd)
+{
+    client->fd = fd;
+    client->sequence = 0;
+    client->tx_count = 0;
+    client->rx_start = 0;
+    client->rx_count = 0;
+    client->discarded_bytes = 0;
+}
+
+void rpc_client_close(rpc_client_t * client)
+{
+    if (client->fd >= 0)
+    {
+        close(client->fd);
+        client->fd = -1;
+    }
+}
+
+// Reads what is there into the receive buffer, moving unread replies to its start first.
+static int rpc_client_read(rpc_client_t * client)
+{
+    if (client->rx_start > 0)
+    {
+        memmove(client->rx_buffer, client->rx_buffer + client->rx_start, client->rx_count);
+        client->rx_start = 0;
+    }
+
+    if (client->rx_count == RPC_CLIENT_RX_BUFFER_SIZE)
+    {
+        return 0;
+    }
+
+    ssize_t count = read(client->fd, client->rx_buffer + client->rx_count, RPC_CLIENT_RX_BUFFER_SIZE - client->rx_count);
+
+    if (count < 0)
+    {
+        return errno == EAGAIN || errno == EINTR ? 0 : PICO_ERROR_IO;
+    }
+
+    client->rx_count += count;
+    return count;
+}
+
+int rpc_client_send(rpc_client_t * client, uint8_t command, const void * payload, uint16_t length)
+{
+    if (RPC_HEADER_SIZE + length > RPC_CLIENT_TX_BUFFER_SIZE)
+    {
+        return PICO_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    if (client->tx_count + RPC_HEADER_SIZE + length > RPC_CLIENT_TX_BUFFER_SIZE)
+    {
+        int result = rpc_client_flush(client);
+
+        if (result < 0)
+        {
+            return result;
+        }
+    }
+
+    uint8_t * request = client->tx_buffer + client->tx_count;
+    uint8_t sequence = client->sequence++;
+
+    request[0] = RPC_REQUEST_SYNC;
+    request[1] = command;
+    request[2] = sequence;
+    rpc_put_uint16(request + 3, length);
+
+    if (length > 0)
+    {
+        memcpy(request + RPC_HEADER_SIZE, payload, length);
+    }
+
+    client->tx_count += RPC_HEADER_SIZE + length;
+    return sequence;
+}
+
+int rpc_client_flush(rpc_client_t * client)
+{
+    size_t written = 0;
+
+    // The Pico answers while the requests are still going out, so replies are read in
+    // between. Otherwise both ends can block writing to a full buffer.
+    while (written < client->tx_count)
+    {
+        struct pollfd poll_fd = {client->fd, POLLOUT, 0};
+
+        if (client->rx_start + client->rx_count < RPC_CLIENT_RX_BUFFER_SIZE || client->rx_start > 0)
+        {
+            poll_fd.events |= POLLIN;
+        }
+
+        if (poll(&poll_fd, 1, -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return PICO_ERROR_IO;
+        }
+
+        if (poll_fd.revents & POLLIN)
+        {
+            if (rpc_client_read(client) < 0)
+            {
+                return PICO_ERROR_IO;
+            }
+        }
+
+        if (poll_fd.revents & POLLOUT)
+        {
+            ssize_t count = write(client->fd, client->tx_buffer + written, client->tx_count - written);
+
+            if (count < 0 && errno != EAGAIN && errno != EINTR)
+            {
+                return PICO_ERROR_IO;
+            }
+
+            written += count > 0 ? count : 0;
+        }
+
+        else if (poll_fd.revents & (POLLERR | POLLHUP))
+        {
+            return PICO_ERROR_IO;
+        }
+    }
+
+    client->tx_count = 0;
+    return written;
+}
+
+int rpc_client_receive(rpc_client_t * client, rpc_reply_t * reply, int timeout_ms)
+{
+    while (true)
+    {
+        uint8_t * data = client->rx_buffer + client->rx_start;
+        size_t count = client->rx_count;
+
+        // Anything before the sync byte is console output.
+        uint8_t * sync = memchr(data, RPC_REPLY_SYNC, count);
+        size_t skip = sync != NULL ? sync - data : count;
+
+        client->discarded_bytes += skip;
+        client->rx_start += skip;
+        client->rx_count -= skip;
+        data += skip;
+        count -= skip;
+
+        if (count >= RPC_HEADER_SIZE)
+        {
+            uint16_t length = rpc_get_uint16(data + 3);
+
+            // Not a reply header after all, look for the next sync byte.
+            if (length > RPC_MAX_PAYLOAD)
+            {
+                client->discarded_bytes++;
+                client->rx_start++;
+                client->rx_count--;
+                continue;
+            }
+
+            if (count >= RPC_HEADER_SIZE + length)
+            {
+                reply->status = (int8_t) data[1];
+                reply->sequence = data[2];
+                reply->length = length;
+                reply->payload = data + RPC_HEADER_SIZE;
+
+                client->rx_start += RPC_HEADER_SIZE + length;
+                client->rx_count -= RPC_HEADER_SIZE + length;
+                return PICO_OK;
+            }
+        }
+
+        struct pollfd poll_fd = {client->fd, POLLIN, 0};
+        int ready = poll(&poll_fd, 1, timeout_ms);
+
+        if (ready == 0)
+        {
+            return PICO_ERROR_TIMEOUT;
+        }
+
+        if (ready < 0 && errno != EINTR)
+        {
+            return PICO_ERROR_IO;
+        }
+
+        if (ready > 0)
+        {
+            int result = rpc_client_read(client);
+
+            if (result < 0 || (result == 0 && (poll_fd.revents & (POLLERR | POLLHUP))))
+            {
+                return PICO_ERROR_IO;
+            }
+        }
+    }
+}
+
+int rpc_client_call(rpc_client_t * client, uint8_t command, const void * payload, uint16_t length, rpc_reply_t * reply, int timeout_ms)
+{
+    int sequence = rpc_client_send(client, command, payload, length);
+
+    if (sequence < 0)
+    {
+        return sequence;
+    }
+
+    int result = rpc_client_flush(client);
+
+    // Replies to requests queued before this one come first.
+    while (result >= 0)
+    {
+        result = rpc_client_receive(client, reply, timeout_ms);
+
+        if (result == PICO_OK && reply->sequence == sequence)
+        {
+            return reply->status;
+        }
+    }
+
+    return result;
+}
+
+#pragma endregion
@@ -0,0 +1,43 @@
+#ifndef PICO_LIBRARY_RPC_CLIENT_H_
+#define PICO_LIBRARY_RPC_CLIENT_H_
+
+#include "src/rpc.h"
+
+// RPC client functions
+// The host end of src/rpc.h on Linux, over the Pico's ttyACM device or any file
+// descriptor. rpc_client_send only queues a request and rpc_client_flush writes the queue
+// in one go, so a batch of requests and its replies cost one USB round trip instead of one
+// each. Replies come back in request order from rpc_client_receive, and console text
+// ahead of a reply is skipped. rpc_client_call is one request and its reply.
+#define RPC_CLIENT_TX_BUFFER_SIZE 65536
+#define RPC_CLIENT_RX_BUFFER_SIZE 65536
+
+typedef struct
+{
+    int status;             // PICO_OK or the PICO_ERROR_* code from the Pico
+    uint8_t sequence;
+    uint16_t length;
+    const uint8_t * payload; // Valid until the next call on the client
+} rpc_reply_t;
+
+typedef struct
+{
+    int fd;
+    uint8_t sequence;
+    size_t tx_count;
+    size_t rx_start;
+    size_t rx_count;
+    uint32_t discarded_bytes;
+    uint8_t tx_buffer[RPC_CLIENT_TX_BUFFER_SIZE];
+    uint8_t rx_buffer[RPC_CLIENT_RX_BUFFER_SIZE];
+} rpc_client_t;
+
+int rpc_client_open(rpc_client_t * client, const char * path);
+void rpc_client_attach(rpc_client_t * client, int fd);
+void rpc_client_close(rpc_client_t * client);
+int rpc_client_send(rpc_client_t * client, uint8_t command, const void * payload, uint16_t length);
+int rpc_client_flush(rpc_client_t * client);
+int rpc_client_receive(rpc_client_t * client, rpc_reply_t * reply, int timeout_ms);
+int rpc_client_call(rpc_client_t * client, uint8_t command, const void * payload, uint16_t length, rpc_reply_t * reply, int timeout_ms);
+
+#endif
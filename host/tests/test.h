@@ -0,0 +1,23 @@
+#ifndef PICO_LIBRARY_TEST_H_
+#define PICO_LIBRARY_TEST_H_
+
+#include <stdio.h>
+
+// Counts and reports a failed check, the test's main returns test_failures != 0.
+extern int test_failures;
+
+#define TEST_CHECK(condition, ...) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            test_failures++; \
+            printf("%s:%d: %s: ", __FILE__, __LINE__, #condition); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+        } \
+    } while (0)
+
+#define TEST_DEFINE int test_failures = 0
+
+#endif
@@ -0,0 +1,173 @@
+#include <stdlib.h>
+#include "src/adc_oversample.h"
+#include "test.h"
+
+// The DNL tables, adc_oversample_decimate_block and adc_calibration_two_point, against
+// values worked out by hand: with every code the same width, code c maps to 16c + 8, the
+// centre of its 16 units on the 16-bit scale.
+
+TEST_DEFINE;
+
+#define CODES (1 << 12)
+
+static void test_tables()
+{
+    static uint16_t table[CODES];
+    static uint32_t histogram[CODES];
+
+    for (int code = 0; code < CODES; code++)
+    {
+        histogram[code] = 100;
+    }
+
+    adc_dnl_table_from_histogram(histogram, table);
+    int mismatches = 0;
+
+    for (int code = 0; code < CODES; code++)
+    {
+        mismatches += table[code] != code * 16 + 8;
+    }
+
+    TEST_CHECK(mismatches == 0, "%d codes off a uniform table", mismatches);
+
+    // The datasheet's spikes: codes 512, 1536, 2560 and 3584 are wider, the rest equal.
+    adc_dnl_table_default(table);
+    bool is_increasing = true;
+
+    for (int code = 1; code < CODES; code++)
+    {
+        is_increasing = is_increasing && table[code] > table[code - 1];
+    }
+
+    TEST_CHECK(is_increasing, "default table not increasing");
+
+    // Centres either side of a spike are half of both widths apart.
+    int step = table[101] - table[100];
+    int spike_step = step * (ADC_DNL_SPIKE_LSB + 2) / 2;
+    int before_spike = table[0x200] - table[0x1ff];
+    int after_spike = table[0x201] - table[0x200];
+    TEST_CHECK(abs(before_spike - spike_step) <= 1 && abs(after_spike - spike_step) <= 1, "spike steps %d and %d against %d", before_spike, after_spike, step);
+    TEST_CHECK(table[0] < step && table[CODES - 1] > UINT16_MAX - step, "ends at %u and %u", table[0], table[CODES - 1]);
+
+    // Nothing to go on leaves the table as it was.
+    memset(histogram, 0, sizeof(histogram));
+    table[0] = 1234;
+    adc_dnl_table_from_histogram(histogram, table);
+    TEST_CHECK(table[0] == 1234, "empty histogram changed the table");
+}
+
+static void test_decimate()
+{
+    static uint16_t table[CODES];
+    static uint32_t histogram[CODES];
+    static uint16_t raw[ADC_OVERSAMPLE_BLOCK];
+    static uint16_t output[ADC_OVERSAMPLE_BLOCK];
+
+    for (int code = 0; code < CODES; code++)
+    {
+        histogram[code] = 1;
+    }
+
+    adc_dnl_table_from_histogram(histogram, table);
+    adc_dnl_table_set(table);
+    adc_calibration_set(0, 0, ADC_CALIBRATION_UNITY);
+
+    // At 12 bits every code comes through on its own, the FIFO's error flag dropped.
+    for (int i = 0; i < ADC_OVERSAMPLE_BLOCK; i++)
+    {
+        raw[i] = (i * 37 % CODES) | (i & 1 ? 0x8000 : 0);
+    }
+
+    adc_oversample_decimate_block(raw, output, ADC_OVERSAMPLE_BLOCK, 12, 0);
+    int mismatches = 0;
+
+    for (int i = 0; i < ADC_OVERSAMPLE_BLOCK; i++)
+    {
+        mismatches += output[i] != (i * 37 % CODES) * 16 + 8;
+    }
+
+    TEST_CHECK(mismatches == 0, "%d of %d 12-bit outputs differ", mismatches, ADC_OVERSAMPLE_BLOCK);
+
+    // Two codes alternating average to halfway between their centres, at every resolution.
+    for (int i = 0; i < ADC_OVERSAMPLE_BLOCK; i++)
+    {
+        raw[i] = i & 1 ? 1001 : 1000;
+    }
+
+    for (uint8_t bits = 13; bits <= ADC_OVERSAMPLE_MAX_BITS; bits++)
+    {
+        size_t count = ADC_OVERSAMPLE_BLOCK >> (2 * (bits - 12));
+        adc_oversample_decimate_block(raw, output, count, bits, 0);
+        mismatches = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            mismatches += output[i] != 1000 * 16 + 16;
+        }
+
+        TEST_CHECK(mismatches == 0, "%d of %zu outputs at %u bits differ, first %u", mismatches, count, bits, output[0]);
+    }
+
+    // Only as many outputs as asked for.
+    output[1] = 0xbeef;
+    adc_oversample_decimate_block(raw, output, 1, 14, 0);
+    TEST_CHECK(output[1] == 0xbeef, "decimate wrote past its count");
+}
+
+static void test_calibration()
+{
+    static uint16_t raw[16];
+    uint16_t output;
+
+    TEST_CHECK(adc_calibration_two_point(5, 1000, 2000, 60000, 62000) == PICO_ERROR_INVALID_ARG, "input 5 accepted");
+    TEST_CHECK(adc_calibration_two_point(1, 60000, 2000, 1000, 62000) == PICO_ERROR_INVALID_ARG, "falling measurements accepted");
+    TEST_CHECK(adc_calibration_two_point(1, 1000, 62000, 60000, 2000) == PICO_ERROR_INVALID_ARG, "falling actual values accepted");
+    TEST_CHECK(adc_calibration_two_point(1, 1000, 2000, 59992, 62000) == PICO_OK, "two point calibration failed");
+
+    // The uniform table from test_decimate is still set, so code c reads 16c + 8 before
+    // calibration, and both points are code centres. They land within a unit of their
+    // actual values.
+    const uint16_t measured[2] = {1000, 59992};
+    const uint16_t actual[2] = {2000, 62000};
+
+    for (int point = 0; point < 2; point++)
+    {
+        for (int i = 0; i < 16; i++)
+        {
+            raw[i] = (measured[point] - 8) / 16;
+        }
+
+        adc_oversample_decimate_block(raw, &output, 1, 14, 1);
+        int error = output - actual[point];
+        TEST_CHECK(error >= -1 && error <= 1, "%u reads %u instead of %u", measured[point], output, actual[point]);
+    }
+
+    // Results past either end saturate.
+    adc_calibration_set(1, 100, ADC_CALIBRATION_UNITY);
+
+    for (int i = 0; i < 16; i++)
+    {
+        raw[i] = 0;
+    }
+
+    adc_oversample_decimate_block(raw, &output, 1, 14, 1);
+    TEST_CHECK(output == 0, "bottom code reads %u", output);
+
+    adc_calibration_set(1, 0, 2 * ADC_CALIBRATION_UNITY);
+
+    for (int i = 0; i < 16; i++)
+    {
+        raw[i] = CODES - 1;
+    }
+
+    adc_oversample_decimate_block(raw, &output, 1, 14, 1);
+    TEST_CHECK(output == UINT16_MAX, "top code at double gain reads %u", output);
+}
+
+int main()
+{
+    test_tables();
+    test_decimate();
+    test_calibration();
+    return test_failures != 0;
+}
@@ -0,0 +1,85 @@
+#include <math.h>
+#include <stdlib.h>
+#include "src/fft.h"
+#include "test.h"
+
+// fft_transform against a double-precision DFT of the same Q15 input.
+
+TEST_DEFINE;
+
+fft_complex_t data[FFT_MAX_POINTS];
+fft_complex_t input[FFT_MAX_POINTS];
+uint16_t samples[FFT_MAX_POINTS];
+uint16_t magnitude[FFT_MAX_POINTS / 2];
+
+// Largest difference, in LSB, between the transform and the DFT scaled by 1 / points.
+static double dft_error(const fft_complex_t * input, const fft_complex_t * output, size_t points)
+{
+    double error = 0;
+
+    for (size_t k = 0; k < points; k++)
+    {
+        double real = 0;
+        double imag = 0;
+
+        for (size_t n = 0; n < points; n++)
+        {
+            double angle = -2 * M_PI * (double) ((k * n) % points) / points;
+            real += input[n].real * cos(angle) - input[n].imag * sin(angle);
+            imag += input[n].real * sin(angle) + input[n].imag * cos(angle);
+        }
+
+        double real_error = fabs(real / points - output[k].real);
+        double imag_error = fabs(imag / points - output[k].imag);
+        error = fmax(error, fmax(real_error, imag_error));
+    }
+
+    return error;
+}
+
+int main()
+{
+    srand(29);
+
+    for (size_t points = FFT_MIN_POINTS; points <= FFT_MAX_POINTS; points *= 2)
+    {
+        // Two tones and some noise, near full scale.
+        size_t bin = points / 16 + 3;
+
+        for (size_t i = 0; i < points; i++)
+        {
+            double value = 2048 + 1400 * sin(2 * M_PI * bin * i / points) + 500 * sin(2 * M_PI * (points / 4 + 1) * i / points) + rand() % 64 - 32;
+            samples[i] = value;
+        }
+
+        TEST_CHECK(fft_load_samples(data, samples, points, false) == PICO_OK, "%zu points", points);
+        memcpy(input, data, points * sizeof(fft_complex_t));
+        TEST_CHECK(fft_transform(data, points) == PICO_OK, "%zu points", points);
+
+        // Every stage truncates, so the error grows with log2(points).
+        double error = dft_error(input, data, points);
+        TEST_CHECK(error <= 8, "%zu points, %.2f LSB", points, error);
+
+        fft_magnitude(data, magnitude, points);
+        TEST_CHECK(fft_peak_bin(magnitude, points / 2) == bin, "%zu points, peak at %zu", points, fft_peak_bin(magnitude, points / 2));
+
+        printf("%4zu points: largest error %.2f LSB, peak %u\n", points, error, magnitude[bin]);
+    }
+
+    // Windowed, the peak stays in its bin.
+    fft_load_samples(data, samples, FFT_MAX_POINTS, true);
+    fft_transform(data, FFT_MAX_POINTS);
+    fft_magnitude(data, magnitude, FFT_MAX_POINTS);
+    TEST_CHECK(fft_peak_bin(magnitude, FFT_MAX_POINTS / 2) == FFT_MAX_POINTS / 16 + 3, "windowed");
+
+    // Both parts at -32768 is 2^31 before the square root.
+    data[0] = (fft_complex_t) {INT16_MIN, INT16_MIN};
+    data[1] = (fft_complex_t) {INT16_MAX, INT16_MIN};
+    fft_magnitude(data, magnitude, 4);
+    TEST_CHECK(magnitude[0] == 46340, "magnitude %u", magnitude[0]);
+    TEST_CHECK(magnitude[1] == 46340, "magnitude %u", magnitude[1]);
+
+    TEST_CHECK(fft_transform(data, 100) == PICO_ERROR_INVALID_ARG, "size");
+
+    return test_failures != 0;
+}
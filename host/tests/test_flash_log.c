@@ -0,0 +1,244 @@
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "src/flash_log.h"
+#include "test.h"
+
+// The log on a file standing in for flash, mapped like the XIP view. Programming only
+// clears bits, as NOR flash does, and a power loss is a budget of pages after which
+// nothing more reaches the file. Every reboot maps the file again and recovers from it.
+
+TEST_DEFINE;
+
+#define LOG_SECTORS 8
+#define LOG_SIZE (LOG_SECTORS * FLASH_SECTOR_SIZE)
+
+const char * file_path;
+int file = -1;
+uint8_t * flash = NULL;
+int pages_left = -1; // Pages programmed before the power goes, -1 for no power loss
+
+static int file_erase_sector(uint32_t offset)
+{
+    memset(flash + offset, 0xff, FLASH_SECTOR_SIZE);
+    return PICO_OK;
+}
+
+static int file_program_page(uint32_t offset, const uint8_t * data)
+{
+    if (pages_left == 0)
+    {
+        return PICO_OK; // Lost, the log does not know
+    }
+
+    if (pages_left > 0)
+    {
+        pages_left--;
+    }
+
+    for (uint32_t i = 0; i < FLASH_PAGE_SIZE; i++)
+    {
+        flash[offset + i] &= data[i];
+    }
+
+    return PICO_OK;
+}
+
+flash_log_backend_t file_backend = {NULL, LOG_SIZE, file_erase_sector, file_program_page};
+
+static void reboot()
+{
+    if (flash != NULL)
+    {
+        msync(flash, LOG_SIZE, MS_SYNC);
+        munmap(flash, LOG_SIZE);
+    }
+
+    flash = mmap(NULL, LOG_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    file_backend.base = flash;
+    pages_left = -1;
+    TEST_CHECK(flash_log_init_with_backend(&file_backend) == PICO_OK, "init");
+}
+
+// Record n is n in its first byte, then n * 7 + i, so any record can be checked on its own.
+static uint16_t record_length(uint32_t n)
+{
+    return 1 + (n * 37) % 600;
+}
+
+static void make_record(uint32_t n, uint8_t * data)
+{
+    data[0] = n;
+
+    for (uint16_t i = 1; i < record_length(n); i++)
+    {
+        data[i] = n * 7 + i;
+    }
+}
+
+// Checks the log holds records first to last, in order, and returns how many it holds.
+static uint32_t check_records(uint32_t first, uint32_t last)
+{
+    static uint8_t expected[FLASH_LOG_MAX_RECORD];
+    flash_log_iterator_t iterator;
+    const uint8_t * data;
+    uint16_t length;
+    uint32_t n = first;
+
+    flash_log_begin(&iterator);
+
+    while (flash_log_next(&iterator, &data, &length))
+    {
+        make_record(n, expected);
+
+        if (length != record_length(n) || memcmp(data, expected, length) != 0)
+        {
+            TEST_CHECK(false, "record %u of %u to %u", n, first, last);
+            return n - first;
+        }
+
+        n++;
+    }
+
+    TEST_CHECK(n == last + 1, "read to %u of %u to %u", n - 1, first, last);
+    return n - first;
+}
+
+static void append_records(uint32_t first, uint32_t last)
+{
+    static uint8_t data[FLASH_LOG_MAX_RECORD];
+
+    for (uint32_t n = first; n <= last; n++)
+    {
+        make_record(n, data);
+        TEST_CHECK(flash_log_append(data, record_length(n)) == PICO_OK, "append %u", n);
+    }
+}
+
+int main()
+{
+    char path[] = "/tmp/flash_log_XXXXXX";
+    file = mkstemp(path);
+    TEST_CHECK(file >= 0 && ftruncate(file, LOG_SIZE) == 0, "file");
+
+    // A blank file is erased flash.
+    flash = mmap(NULL, LOG_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+    memset(flash, 0xff, LOG_SIZE);
+    munmap(flash, LOG_SIZE);
+    flash = NULL;
+
+    // Records survive a reboot, the unflushed page only after flash_log_flush.
+    reboot();
+    TEST_CHECK(check_records(0, -1) == 0, "empty");
+    append_records(0, 19);
+    flash_log_flush();
+    reboot();
+    check_records(0, 19);
+
+    // Appends continue in the recovered page.
+    append_records(20, 29);
+    flash_log_flush();
+    reboot();
+    check_records(0, 29);
+
+    // A record the CRC has to catch: its header and first page reach flash, the power
+    // goes before the page with the rest of it and the CRC.
+    uint8_t data[600];
+    uint32_t n = 30;
+
+    while (record_length(n) < 2 * FLASH_PAGE_SIZE)
+    {
+        n++;
+    }
+
+    append_records(30, n - 1);
+    flash_log_flush();
+    make_record(n, data);
+    pages_left = 1;
+    flash_log_append(data, record_length(n));
+    flash_log_flush();
+
+    flash_log_stats_t stats;
+    flash_log_get_stats(&stats);
+    uint32_t sequence = stats.sequence;
+
+    reboot();
+    check_records(0, n - 1);
+
+    // The torn record's sector is given up, the next record starts a new one.
+    append_records(n, n + 3);
+    flash_log_flush();
+    flash_log_get_stats(&stats);
+    TEST_CHECK(stats.sequence == sequence + 1, "sequence %u after %u", stats.sequence, sequence);
+
+    // A torn header is not an end either.
+    make_record(n + 4, data);
+    pages_left = 0;
+    flash_log_append(data, record_length(n + 4));
+    flash_log_flush();
+    reboot();
+    check_records(0, n + 3);
+
+    // Wrapping drops the oldest sector, what is left is still in order.
+    append_records(n + 4, n + 400);
+    flash_log_flush();
+    reboot();
+
+    uint32_t kept = 0;
+    flash_log_iterator_t iterator;
+    const uint8_t * record;
+    uint16_t length;
+    flash_log_begin(&iterator);
+
+    if (flash_log_next(&iterator, &record, &length))
+    {
+        // Record numbers fit the first byte, the length tells them apart from there.
+        uint32_t first = n + 400;
+
+        while (first > 0 && !(record_length(first) == length && (uint8_t) first == record[0]))
+        {
+            first--;
+        }
+
+        kept = check_records(first, n + 400);
+    }
+
+    TEST_CHECK(kept > 0 && kept < n + 400, "kept %u after wrapping", kept);
+
+    // Packed samples read back with unpack12_block.
+    uint16_t samples[300];
+    uint16_t unpacked[300];
+
+    for (int i = 0; i < 300; i++)
+    {
+        samples[i] = (i * 13) & 0xfff;
+    }
+
+    TEST_CHECK(flash_log_append_packed(samples, 300) == PICO_OK, "append packed");
+    flash_log_flush();
+    reboot();
+
+    const uint8_t * last = NULL;
+    uint16_t last_length = 0;
+    flash_log_begin(&iterator);
+
+    while (flash_log_next(&iterator, &record, &length))
+    {
+        last = record;
+        last_length = length;
+    }
+
+    TEST_CHECK(last != NULL && PACK12_COUNT(last_length) == 300, "packed length %u", last_length);
+
+    if (last != NULL)
+    {
+        unpack12_block(last, unpacked, 300);
+        TEST_CHECK(memcmp(samples, unpacked, sizeof(samples)) == 0, "packed samples");
+    }
+
+    munmap(flash, LOG_SIZE);
+    close(file);
+    unlink(path);
+    return test_failures != 0;
+}
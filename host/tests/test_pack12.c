@@ -0,0 +1,70 @@
+#include <stdlib.h>
+#include "src/pack12.h"
+#include "test.h"
+
+// pack12_block and unpack12_block against a bit at a time reference, on both the word and
+// the byte paths and in place.
+
+TEST_DEFINE;
+
+#define MAX_SAMPLES 1000
+
+static void reference_pack(const uint16_t * samples, uint8_t * packed, size_t count)
+{
+    memset(packed, 0, PACK12_BYTES(count));
+
+    for (size_t bit = 0; bit < count * 12; bit++)
+    {
+        if ((samples[bit / 12] >> (bit % 12)) & 1)
+        {
+            packed[bit / 8] |= 1 << (bit % 8);
+        }
+    }
+}
+
+int main()
+{
+    static uint16_t samples[MAX_SAMPLES + 8] __aligned(4);
+    static uint16_t unpacked[MAX_SAMPLES + 8] __aligned(4);
+    static uint8_t packed[PACK12_BYTES(MAX_SAMPLES) + 8] __aligned(4);
+    static uint8_t expected[PACK12_BYTES(MAX_SAMPLES) + 8];
+    static uint16_t in_place[MAX_SAMPLES + 8] __aligned(4);
+    srand(49);
+
+    for (int run = 0; run < 2000; run++)
+    {
+        size_t count = rand() % MAX_SAMPLES;
+        size_t sample_offset = rand() % 2;  // 2-byte offset, forces the byte path
+        size_t packed_offset = rand() % 4;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            // Bits above the 12th are noise that must be dropped.
+            samples[sample_offset + i] = rand() & 0xffff;
+        }
+
+        reference_pack(samples + sample_offset, expected, count);
+
+        size_t bytes = pack12_block(samples + sample_offset, packed + packed_offset, count);
+        TEST_CHECK(bytes == PACK12_BYTES(count), "%zu samples, %zu bytes", count, bytes);
+        TEST_CHECK(memcmp(packed + packed_offset, expected, bytes) == 0, "%zu samples at +%zu to +%zu", count, sample_offset, packed_offset);
+        TEST_CHECK(PACK12_COUNT(bytes) == count, "%zu samples", count);
+
+        unpack12_block(packed + packed_offset, unpacked + sample_offset, count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (unpacked[sample_offset + i] != (samples[sample_offset + i] & 0xfff))
+            {
+                TEST_CHECK(false, "%zu samples at +%zu to +%zu, sample %zu", count, sample_offset, packed_offset, i);
+                break;
+            }
+        }
+
+        memcpy(in_place, samples + sample_offset, count * sizeof(uint16_t));
+        pack12_block(in_place, in_place, count);
+        TEST_CHECK(memcmp(in_place, expected, bytes) == 0, "%zu samples in place", count);
+    }
+
+    return test_failures != 0;
+}
@@ -0,0 +1,122 @@
+#include <math.h>
+#include <stdlib.h>
+#include "src/rice.h"
+#include "src/usb_stream.h"
+#include "test.h"
+
+// rice_encode_block and rice_decode_block round trips for every order, on random samples
+// that escape to raw partitions and smooth ones that compress, out of place and in place,
+// and with the padding byte a usb_stream block can carry. Damaged blocks must be refused.
+
+TEST_DEFINE;
+
+#define MAX_SAMPLES 3000
+#define STREAM_SAMPLES ((USB_STREAM_BLOCK_SIZE - sizeof(usb_stream_header_t)) / 2)
+
+static void fill_random(uint16_t * samples, size_t count)
+{
+    // Bits above the 12th are noise that must be dropped.
+    for (size_t i = 0; i < count; i++)
+    {
+        samples[i] = rand() & 0xffff;
+    }
+}
+
+static void fill_smooth(uint16_t * samples, size_t count)
+{
+    double step = 2 * M_PI * (1 + rand() % 20) / count;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        samples[i] = lround(2048 + 1800 * sin(step * i)) + rand() % 5 - 2;
+    }
+}
+
+static bool is_decoded(const uint16_t * decoded, const uint16_t * samples, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (decoded[i] != (samples[i] & 0xfff))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void check_round_trip(const uint16_t * samples, size_t count, uint8_t order, const char * signal)
+{
+    static uint8_t encoded[RICE_MAX_BYTES(MAX_SAMPLES) + 1];
+    static uint16_t decoded[MAX_SAMPLES];
+    static uint16_t in_place[RICE_MAX_BYTES(MAX_SAMPLES) / 2 + MAX_SAMPLES];
+
+    size_t length = rice_encode_block(samples, count, order, encoded);
+    TEST_CHECK(length >= RICE_HEADER_SIZE && length <= RICE_MAX_BYTES(count), "%s, %zu samples, order %u: %zu bytes", signal, count, order, length);
+
+    int result = rice_decode_block(encoded, length, decoded, MAX_SAMPLES);
+    TEST_CHECK(result == (int) count && is_decoded(decoded, samples, count), "%s, %zu samples, order %u: decode returned %d", signal, count, order, result);
+
+    // The zero byte usb_stream adds to a block that would end on a whole packet.
+    encoded[length] = 0;
+    result = rice_decode_block(encoded, length + 1, decoded, MAX_SAMPLES);
+    TEST_CHECK(result == (int) count && is_decoded(decoded, samples, count), "%s, %zu samples, order %u: padded decode returned %d", signal, count, order, result);
+
+    memcpy(in_place, samples, count * sizeof(uint16_t));
+    size_t in_place_length = rice_encode_block(in_place, count, order, in_place);
+    TEST_CHECK(in_place_length == length && memcmp(in_place, encoded, length) == 0, "%s, %zu samples, order %u in place", signal, count, order);
+}
+
+int main()
+{
+    static uint16_t samples[MAX_SAMPLES];
+    static uint16_t decoded[MAX_SAMPLES];
+    static uint8_t encoded[RICE_MAX_BYTES(MAX_SAMPLES)];
+    srand(50);
+
+    for (int run = 0; run < 300; run++)
+    {
+        size_t count = 1 + rand() % MAX_SAMPLES;
+
+        for (uint8_t order = 0; order <= 2; order++)
+        {
+            fill_random(samples, count);
+            check_round_trip(samples, count, order, "random");
+            fill_smooth(samples, count);
+            check_round_trip(samples, count, order, "smooth");
+        }
+    }
+
+    // Blocks shorter than the warm-up samples.
+    for (size_t count = 1; count <= 3; count++)
+    {
+        for (uint8_t order = 0; order <= 2; order++)
+        {
+            fill_random(samples, count);
+            check_round_trip(samples, count, order, "short");
+        }
+    }
+
+    // The stream's block, compressed, leaves room for its header and the padding byte.
+    TEST_CHECK(sizeof(usb_stream_header_t) + RICE_MAX_BYTES(STREAM_SAMPLES) + 1 <= USB_STREAM_BLOCK_SIZE, "%zu bytes for a stream block", RICE_MAX_BYTES(STREAM_SAMPLES));
+
+    // With the stream's order a smooth signal has to beat packed samples.
+    fill_smooth(samples, STREAM_SAMPLES);
+    size_t length = rice_encode_block(samples, STREAM_SAMPLES, 1, encoded);
+    TEST_CHECK(length < STREAM_SAMPLES * 3 / 2, "smooth block of %zu bytes", length);
+
+    TEST_CHECK(rice_encode_block(samples, 0, 1, encoded) == 0, "empty block encoded");
+    TEST_CHECK(rice_encode_block(samples, 10, 3, encoded) == 0, "order 3 encoded");
+
+    // Damaged and cut short blocks are refused.
+    fill_random(samples, 1000);
+    length = rice_encode_block(samples, 1000, 2, encoded);
+    TEST_CHECK(rice_decode_block(encoded, length / 2, decoded, MAX_SAMPLES) == PICO_ERROR_INVALID_DATA, "truncated block decoded");
+    TEST_CHECK(rice_decode_block(encoded, 3, decoded, MAX_SAMPLES) == PICO_ERROR_INVALID_DATA, "block shorter than its header decoded");
+    TEST_CHECK(rice_decode_block(encoded, length, decoded, 999) == PICO_ERROR_BUFFER_TOO_SMALL, "block decoded into too few samples");
+
+    encoded[2] = 3;
+    TEST_CHECK(rice_decode_block(encoded, length, decoded, MAX_SAMPLES) == PICO_ERROR_INVALID_DATA, "block with order 3 decoded");
+
+    return test_failures != 0;
+}
@@ -0,0 +1,276 @@
+#include <poll.h>
+#include <pthread.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+#include "src/rpc.h"
+#include "host/rpc_client.h"
+#include "test.h"
+
+// The protocol over a pty pair, the slave standing in for the Pico's USB CDC port. A
+// thread runs the device end as rpc_serve does, with a handler in place of the hardware
+// commands, and the client talks to the master. Stats are compared once the thread has
+// returned on RPC_EXIT.
+
+TEST_DEFINE;
+
+#define TIMEOUT_MS 1000
+#define PIPELINED 2000
+
+int device_fd = -1;
+pthread_t device_thread;
+volatile bool is_device_running = false;
+uint16_t adc_reading = 0;
+rpc_client_t client;
+
+static void device_write(const uint8_t * data, size_t count)
+{
+    while (count > 0)
+    {
+        ssize_t written = write(device_fd, data, count);
+
+        if (written > 0)
+        {
+            data += written;
+            count -= written;
+        }
+    }
+}
+
+static int device_handle(uint8_t command, const uint8_t * payload, uint16_t length, uint8_t * reply)
+{
+    switch (command)
+    {
+        case RPC_EXIT:
+        {
+            is_device_running = false;
+            return 0;
+        }
+
+        case RPC_ADC_READ:
+        {
+            rpc_put_uint16(reply, adc_reading++ & 0xfff);
+            return 2;
+        }
+
+        case RPC_ADC_READ_BULK:
+        {
+            if (length != 2)
+            {
+                return PICO_ERROR_INVALID_ARG;
+            }
+
+            uint16_t count = rpc_get_uint16(payload);
+
+            if (count > RPC_MAX_PAYLOAD / 2)
+            {
+                return PICO_ERROR_BUFFER_TOO_SMALL;
+            }
+
+            for (uint16_t i = 0; i < count; i++)
+            {
+                rpc_put_uint16(reply + i * 2, i * 3 & 0xfff);
+            }
+
+            return count * 2;
+        }
+
+        default:
+            return PICO_ERROR_INVALID_ARG;
+    }
+}
+
+static void * device_serve(void * param)
+{
+    uint8_t chunk[256];
+
+    while (is_device_running)
+    {
+        // Waits while there is nothing to answer, otherwise flushes once the input stops.
+        struct pollfd poll_fd = {device_fd, POLLIN, 0};
+
+        if (poll(&poll_fd, 1, rpc_pending() > 0 ? 0 : 10) > 0)
+        {
+            ssize_t count = read(device_fd, chunk, sizeof(chunk));
+
+            if (count > 0)
+            {
+                rpc_receive(chunk, count);
+            }
+        }
+
+        else
+        {
+            rpc_flush();
+        }
+    }
+
+    rpc_flush();
+    return NULL;
+}
+
+static void device_start()
+{
+    rpc_init_with_handler(device_write, device_handle);
+    is_device_running = true;
+    pthread_create(&device_thread, NULL, device_serve, NULL);
+}
+
+static void device_stop(rpc_stats_t * stats)
+{
+    rpc_reply_t reply;
+    int result = rpc_client_call(&client, RPC_EXIT, NULL, 0, &reply, TIMEOUT_MS);
+    TEST_CHECK(result == PICO_OK, "exit returned %d", result);
+
+    pthread_join(device_thread, NULL);
+    rpc_get_stats(stats);
+}
+
+static void test_framing()
+{
+    rpc_reply_t reply;
+    rpc_stats_t stats;
+    device_start();
+
+    uint8_t payload[RPC_MAX_PAYLOAD];
+
+    for (size_t i = 0; i < sizeof(payload); i++)
+    {
+        payload[i] = i * 7;
+    }
+
+    int result = rpc_client_call(&client, RPC_PING, payload, sizeof(payload), &reply, TIMEOUT_MS);
+    TEST_CHECK(result == PICO_OK && reply.length == sizeof(payload) && memcmp(reply.payload, payload, sizeof(payload)) == 0, "ping of %zu bytes returned %d with %u bytes", sizeof(payload), result, reply.length);
+
+    // A frame arriving a byte at a time.
+    uint8_t frame[RPC_HEADER_SIZE + 3] = {RPC_REQUEST_SYNC, RPC_PING, 0x42, 3, 0, 'a', 'b', 'c'};
+
+    for (size_t i = 0; i < sizeof(frame); i++)
+    {
+        write(client.fd, frame + i, 1);
+        usleep(2000);
+    }
+
+    result = rpc_client_receive(&client, &reply, TIMEOUT_MS);
+    TEST_CHECK(result == PICO_OK && reply.sequence == 0x42 && reply.length == 3 && memcmp(reply.payload, "abc", 3) == 0, "split frame returned %d, sequence %u", result, reply.sequence);
+
+    result = rpc_client_call(&client, RPC_ADC_READ_BULK, (uint8_t[]) {0x00, 0x02}, 2, &reply, TIMEOUT_MS);
+    bool is_bulk_equal = result == PICO_OK && reply.length == RPC_MAX_PAYLOAD;
+
+    for (uint16_t i = 0; is_bulk_equal && i < RPC_MAX_PAYLOAD / 2; i++)
+    {
+        is_bulk_equal = rpc_get_uint16(reply.payload + i * 2) == (i * 3 & 0xfff);
+    }
+
+    TEST_CHECK(is_bulk_equal, "bulk read of 512 returned %d with %u bytes", result, reply.length);
+
+    // Console text from the Pico ahead of a reply.
+    const char * text = "Binary RPC mode\r\n";
+    write(device_fd, text, strlen(text));
+    result = rpc_client_call(&client, RPC_PING, NULL, 0, &reply, TIMEOUT_MS);
+    TEST_CHECK(result == PICO_OK && client.discarded_bytes == strlen(text), "ping after text returned %d, %u bytes skipped", result, client.discarded_bytes);
+
+    device_stop(&stats);
+    TEST_CHECK(stats.frames == 5 && stats.errors == 0 && stats.discarded_bytes == 0, "%u frames, %u errors, %u discarded", stats.frames, stats.errors, stats.discarded_bytes);
+}
+
+static void test_batching()
+{
+    rpc_reply_t reply;
+    rpc_stats_t stats;
+    device_start();
+
+    uint64_t start = time_us_64();
+
+    for (int i = 0; i < PIPELINED; i++)
+    {
+        rpc_client_send(&client, RPC_ADC_READ, NULL, 0);
+    }
+
+    int result = rpc_client_flush(&client);
+    TEST_CHECK(result == PIPELINED * RPC_HEADER_SIZE, "flush wrote %d bytes", result);
+
+    uint8_t first_sequence = client.sequence - PIPELINED;
+    int in_order = 0;
+
+    for (int i = 0; i < PIPELINED; i++)
+    {
+        result = rpc_client_receive(&client, &reply, TIMEOUT_MS);
+
+        if (result == PICO_OK && reply.status == PICO_OK && reply.sequence == (uint8_t) (first_sequence + i) && reply.length == 2 && rpc_get_uint16(reply.payload) == (i & 0xfff))
+        {
+            in_order++;
+        }
+    }
+
+    uint64_t elapsed = time_us_64() - start;
+    printf("%d pipelined commands in %llu us, %.0f per ms\n", PIPELINED, (unsigned long long) elapsed, PIPELINED * 1000.0 / (elapsed > 0 ? elapsed : 1));
+    TEST_CHECK(in_order == PIPELINED, "%d of %d replies in order", in_order, PIPELINED);
+
+    device_stop(&stats);
+
+    // Each batch holds up to RPC_TX_BUFFER_SIZE / RPC_HEADER_SIZE - 1 replies, so a
+    // pipelined run needs far fewer writes than replies.
+    TEST_CHECK(stats.frames == PIPELINED + 1, "%u frames", stats.frames);
+    TEST_CHECK(stats.batches * 10 < stats.frames, "%u batches for %u frames", stats.batches, stats.frames);
+}
+
+static void test_errors()
+{
+    rpc_reply_t reply;
+    rpc_stats_t stats;
+    device_start();
+
+    int result = rpc_client_call(&client, 0x7f, NULL, 0, &reply, TIMEOUT_MS);
+    TEST_CHECK(result == PICO_ERROR_INVALID_ARG && reply.length == 0, "unknown command returned %d", result);
+
+    result = rpc_client_call(&client, RPC_ADC_READ_BULK, (uint8_t[]) {0x01, 0x02}, 2, &reply, TIMEOUT_MS);
+    TEST_CHECK(result == PICO_ERROR_BUFFER_TOO_SMALL, "bulk read of 513 returned %d", result);
+
+    // Too long to buffer, full of request sync bytes that must not start a frame.
+    static uint8_t oversized[2 * RPC_MAX_PAYLOAD];
+    memset(oversized, RPC_REQUEST_SYNC, sizeof(oversized));
+    result = rpc_client_call(&client, RPC_PING, oversized, sizeof(oversized), &reply, TIMEOUT_MS);
+    TEST_CHECK(result == PICO_ERROR_BUFFER_TOO_SMALL && reply.length == 0, "oversized ping returned %d", result);
+
+    // Noise between frames, then a request that must still be answered.
+    const char * noise = "\r\nhello\r\n";
+    write(client.fd, noise, strlen(noise));
+    result = rpc_client_call(&client, RPC_PING, "ok", 2, &reply, TIMEOUT_MS);
+    TEST_CHECK(result == PICO_OK && reply.length == 2 && memcmp(reply.payload, "ok", 2) == 0, "ping after noise returned %d", result);
+
+    device_stop(&stats);
+    TEST_CHECK(stats.frames == 5 && stats.errors == 3, "%u frames, %u errors", stats.frames, stats.errors);
+    TEST_CHECK(stats.discarded_bytes == sizeof(oversized) + strlen(noise), "%u bytes discarded", stats.discarded_bytes);
+
+    // Nothing answers now.
+    result = rpc_client_call(&client, RPC_PING, NULL, 0, &reply, 50);
+    TEST_CHECK(result == PICO_ERROR_TIMEOUT, "ping without a device returned %d", result);
+    tcflush(device_fd, TCIFLUSH);
+}
+
+int main()
+{
+    int master_fd;
+    struct termios options;
+
+    if (openpty(&master_fd, &device_fd, NULL, NULL, NULL) != 0)
+    {
+        perror("openpty");
+        return 1;
+    }
+
+    tcgetattr(device_fd, &options);
+    cfmakeraw(&options);
+    tcsetattr(device_fd, TCSANOW, &options);
+
+    rpc_client_attach(&client, master_fd);
+
+    test_framing();
+    test_batching();
+    test_errors();
+
+    rpc_client_close(&client);
+    close(device_fd);
+    return test_failures != 0;
+}
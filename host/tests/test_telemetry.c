@@ -0,0 +1,185 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "src/telemetry.h"
+#include "test.h"
+
+// The packets over a real UDP socket on the loopback interface, standing in for lwIP. The
+// send function is the one telemetry_udp_open installs on Pico W, minus lwIP: the packet
+// is sent without waiting and a failed send counts as a drop.
+
+TEST_DEFINE;
+
+int sender = -1;
+int receiver = -1;
+bool is_send_failing = false;
+
+static bool udp_send(const uint8_t * data, size_t length)
+{
+    return !is_send_failing && send(sender, data, length, MSG_DONTWAIT) == (ssize_t) length;
+}
+
+static uint16_t get_uint16(const uint8_t * data)
+{
+    return data[0] | (data[1] << 8);
+}
+
+static uint32_t get_uint32(const uint8_t * data)
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t) data[3] << 24);
+}
+
+// Returns the datagram's length, or 0 if none is waiting.
+static ssize_t receive_packet(uint8_t * packet)
+{
+    ssize_t length = recv(receiver, packet, TELEMETRY_PACKET_SIZE + 1, MSG_DONTWAIT);
+    return length < 0 ? 0 : length;
+}
+
+static bool is_header_valid(const uint8_t * packet, ssize_t length, uint8_t records, uint32_t sequence)
+{
+    return length == TELEMETRY_HEADER_SIZE + records * TELEMETRY_RECORD_SIZE
+        && get_uint16(packet) == TELEMETRY_MAGIC
+        && packet[2] == TELEMETRY_VERSION
+        && packet[3] == records
+        && get_uint32(packet + 4) == sequence;
+}
+
+static void test_batching()
+{
+    uint8_t packet[TELEMETRY_PACKET_SIZE + 1];
+    telemetry_init(udp_send, 0);
+
+    // Two full packets go out as they fill, the rest waits.
+    for (int i = 0; i < 2 * TELEMETRY_MAX_RECORDS + 5; i++)
+    {
+        telemetry_add_adc(i % 5, i & 0xfff);
+    }
+
+    for (uint32_t sequence = 0; sequence < 2; sequence++)
+    {
+        ssize_t length = receive_packet(packet);
+        TEST_CHECK(is_header_valid(packet, length, TELEMETRY_MAX_RECORDS, sequence), "packet %u is %zd bytes with %u records", sequence, length, packet[3]);
+        TEST_CHECK(length <= TELEMETRY_PACKET_SIZE && length + TELEMETRY_RECORD_SIZE > TELEMETRY_PACKET_SIZE, "full packet of %zd bytes", length);
+
+        int mismatches = 0;
+
+        for (int j = 0; j < TELEMETRY_MAX_RECORDS; j++)
+        {
+            const uint8_t * record = packet + TELEMETRY_HEADER_SIZE + j * TELEMETRY_RECORD_SIZE;
+            int i = sequence * TELEMETRY_MAX_RECORDS + j;
+            mismatches += record[0] != TELEMETRY_ADC || record[1] != i % 5 || get_uint16(record + 4) != (i & 0xfff) || get_uint16(record + 2) > 100;
+        }
+
+        TEST_CHECK(mismatches == 0, "%d records of packet %u differ", mismatches, sequence);
+    }
+
+    TEST_CHECK(receive_packet(packet) == 0, "partial packet sent early");
+    TEST_CHECK(telemetry_flush() == TELEMETRY_HEADER_SIZE + 5 * TELEMETRY_RECORD_SIZE, "flush of the partial packet");
+    TEST_CHECK(is_header_valid(packet, receive_packet(packet), 5, 2), "partial packet");
+    TEST_CHECK(telemetry_flush() == 0, "flush with nothing batched");
+
+    telemetry_stats_t stats;
+    telemetry_get_stats(&stats);
+    TEST_CHECK(stats.packets_sent == 3 && stats.packets_dropped == 0 && stats.records == 2 * TELEMETRY_MAX_RECORDS + 5, "%u sent, %u dropped, %u records", stats.packets_sent, stats.packets_dropped, stats.records);
+    TEST_CHECK(stats.bytes_sent == 3 * TELEMETRY_HEADER_SIZE + (2 * TELEMETRY_MAX_RECORDS + 5) * TELEMETRY_RECORD_SIZE, "%u bytes sent", stats.bytes_sent);
+}
+
+static void test_poll()
+{
+    uint8_t packet[TELEMETRY_PACKET_SIZE + 1];
+    telemetry_init(udp_send, 20);
+
+    for (int i = 0; i < 3; i++)
+    {
+        telemetry_add_temperature(21.5f);
+    }
+
+    telemetry_poll();
+    TEST_CHECK(receive_packet(packet) == 0, "packet flushed before flush_ms");
+
+    usleep(30000);
+    telemetry_poll();
+    ssize_t length = receive_packet(packet);
+    TEST_CHECK(is_header_valid(packet, length, 3, 0), "polled packet is %zd bytes", length);
+
+    telemetry_poll();
+    TEST_CHECK(receive_packet(packet) == 0, "empty packet polled out");
+}
+
+static void test_values()
+{
+    uint8_t packet[TELEMETRY_PACKET_SIZE + 1];
+    telemetry_init(udp_send, 0);
+
+    telemetry_add_vsys(true, 4.1234f);
+    telemetry_add_vsys(false, 100.0f);
+    telemetry_add_temperature(-12.345f);
+    telemetry_add_temperature(1000.0f);
+    telemetry_flush();
+
+    ssize_t length = receive_packet(packet);
+    TEST_CHECK(is_header_valid(packet, length, 4, 0), "packet of %zd bytes", length);
+
+    const uint8_t * record = packet + TELEMETRY_HEADER_SIZE;
+    TEST_CHECK(record[0] == TELEMETRY_VSYS && record[1] == 1 && get_uint16(record + 4) == 4123, "VSYS %u mV", get_uint16(record + 4));
+    record += TELEMETRY_RECORD_SIZE;
+    TEST_CHECK(record[1] == 0 && get_uint16(record + 4) == UINT16_MAX, "VSYS %u mV saturated", get_uint16(record + 4));
+    record += TELEMETRY_RECORD_SIZE;
+    TEST_CHECK(record[0] == TELEMETRY_TEMPERATURE && (int16_t) get_uint16(record + 4) == -1235, "temperature %d", (int16_t) get_uint16(record + 4));
+    record += TELEMETRY_RECORD_SIZE;
+    TEST_CHECK((int16_t) get_uint16(record + 4) == INT16_MAX, "temperature %d saturated", (int16_t) get_uint16(record + 4));
+}
+
+static void test_drops()
+{
+    uint8_t packet[TELEMETRY_PACKET_SIZE + 1];
+    telemetry_init(udp_send, 0);
+
+    // A dropped packet still takes its sequence number, so the receiver sees the gap.
+    is_send_failing = true;
+    telemetry_add_adc(0, 1);
+    TEST_CHECK(telemetry_flush() == PICO_ERROR_INSUFFICIENT_RESOURCES, "failed send");
+
+    is_send_failing = false;
+    telemetry_add_adc(0, 2);
+    telemetry_flush();
+    TEST_CHECK(is_header_valid(packet, receive_packet(packet), 1, 1), "packet after the drop has sequence %u", get_uint32(packet + 4));
+
+    telemetry_stats_t stats;
+    telemetry_get_stats(&stats);
+    TEST_CHECK(stats.packets_sent == 1 && stats.packets_dropped == 1, "%u sent, %u dropped", stats.packets_sent, stats.packets_dropped);
+}
+
+int main()
+{
+    struct sockaddr_in address = {0};
+    socklen_t address_length = sizeof(address);
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    receiver = socket(AF_INET, SOCK_DGRAM, 0);
+    sender = socket(AF_INET, SOCK_DGRAM, 0);
+
+    if (bind(receiver, (struct sockaddr *) &address, sizeof(address)) != 0
+        || getsockname(receiver, (struct sockaddr *) &address, &address_length) != 0
+        || connect(sender, (struct sockaddr *) &address, sizeof(address)) != 0)
+    {
+        perror("socket");
+        return 1;
+    }
+
+    // Loopback delivers at once, but give the full packets room to queue.
+    int buffer_size = 16 * TELEMETRY_PACKET_SIZE;
+    setsockopt(receiver, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+
+    test_batching();
+    test_poll();
+    test_values();
+    test_drops();
+
+    close(sender);
+    close(receiver);
+    return test_failures != 0;
+}
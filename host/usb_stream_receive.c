@@ -0,0 +1,330 @@
+#define _GNU_SOURCE // mremap
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <linux/usbdevice_fs.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "src/usb_stream.h"
+
+// Receives a usb_stream from a Pico into a file, through usbfs so nothing beyond the kernel
+// is needed. The vendor interface is claimed and USB_STREAM_URBS bulk reads are kept
+// queued on its endpoint, so the Pico always has somewhere to send its next block. Block
+// headers are checked for gaps in the sequence and for blocks the Pico dropped, and the
+// samples after them go into the output file through a growing shared mapping. With -f
+// each block is written as its uint32 length and its bytes, which compressed streams need
+// to find the block boundaries again, and rice_decode turns such a file into samples:
+//     usb_stream_receive [-d /dev/bus/usb/BBB/DDD] [-n blocks] [-f] output
+#define USB_STREAM_URBS 8
+#define USB_STREAM_FILE_STEP (16 * 1024 * 1024)
+
+typedef struct
+{
+    int fd;
+    uint8_t * data;
+    size_t size;        // Bytes written
+    size_t mapped;      // Bytes mapped, the file's length until it is closed
+} output_file_t;
+
+typedef struct
+{
+    uint32_t blocks;
+    uint32_t missing_blocks;    // Gaps in the sequence, lost between the Pico and here
+    uint32_t dropped_blocks;    // Dropped on the Pico, from the block headers
+    uint64_t bytes;
+    usb_stream_header_t last;
+} receive_stats_t;
+
+volatile sig_atomic_t is_receiving = true;
+
+static void stop_receiving(int signal)
+{
+    is_receiving = false;
+}
+
+// Finds the Pico's usbfs node from the IDs in sysfs.
+static int usb_stream_find_device(char * path, size_t size)
+{
+    DIR * devices = opendir("/sys/bus/usb/devices");
+
+    if (devices == NULL)
+    {
+        return PICO_ERROR_NOT_FOUND;
+    }
+
+    struct dirent * entry;
+    int result = PICO_ERROR_NOT_FOUND;
+
+    while (result != PICO_OK && (entry = readdir(devices)) != NULL)
+    {
+        unsigned int values[4];
+        const char * names[4] = {"idVendor", "idProduct", "busnum", "devnum"};
+        int found = 0;
+
+        for (int i = 0; i < 4; i++)
+        {
+            char attribute[512];
+            snprintf(attribute, sizeof(attribute), "/sys/bus/usb/devices/%s/%s", entry->d_name, names[i]);
+            FILE * file = fopen(attribute, "r");
+
+            if (file != NULL)
+            {
+                found += fscanf(file, i < 2 ? "%x" : "%u", &values[i]) == 1;
+                fclose(file);
+            }
+        }
+
+        if (found == 4 && values[0] == USB_STREAM_VID && values[1] == USB_STREAM_PID)
+        {
+            snprintf(path, size, "/dev/bus/usb/%03u/%03u", values[2], values[3]);
+            result = PICO_OK;
+        }
+    }
+
+    closedir(devices);
+    return result;
+}
+
+static int output_reserve(output_file_t * output, size_t count)
+{
+    if (output->size + count <= output->mapped)
+    {
+        return PICO_OK;
+    }
+
+    size_t mapped = output->mapped + USB_STREAM_FILE_STEP;
+
+    if (ftruncate(output->fd, mapped) != 0)
+    {
+        return PICO_ERROR_IO;
+    }
+
+    uint8_t * data = output->data == NULL
+        ? mmap(NULL, mapped, PROT_READ | PROT_WRITE, MAP_SHARED, output->fd, 0)
+        : mremap(output->data, output->mapped, mapped, MREMAP_MAYMOVE);
+
+    if (data == MAP_FAILED)
+    {
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+
+    output->data = data;
+    output->mapped = mapped;
+    return PICO_OK;
+}
+
+static int output_write(output_file_t * output, const void * data, size_t count)
+{
+    int result = output_reserve(output, count);
+
+    if (result == PICO_OK)
+    {
+        memcpy(output->data + output->size, data, count);
+        output->size += count;
+    }
+
+    return result;
+}
+
+static void output_close(output_file_t * output)
+{
+    if (output->data != NULL)
+    {
+        munmap(output->data, output->mapped);
+    }
+
+    // Drops the unused end of the last step.
+    ftruncate(output->fd, output->size);
+    close(output->fd);
+}
+
+// Checks a block's header against the one before and stores its samples.
+static int receive_block(output_file_t * output, receive_stats_t * stats, const uint8_t * block, size_t length, bool is_framed)
+{
+    usb_stream_header_t header;
+
+    if (length < sizeof(header))
+    {
+        return PICO_ERROR_INVALID_DATA;
+    }
+
+    memcpy(&header, block, sizeof(header));
+
+    // Blocks before the host opened the endpoint were dropped too, so counting starts at
+    // the first block received.
+    if (stats->blocks > 0)
+    {
+        uint32_t missing = header.sequence - stats->last.sequence - 1;
+        uint32_t dropped = header.dropped_blocks - stats->last.dropped_blocks;
+
+        if (missing != 0 || dropped != 0)
+        {
+            fprintf(stderr, "Block %u: %u missing, %u dropped on the Pico\n", header.sequence, missing, dropped);
+        }
+
+        stats->missing_blocks += missing;
+        stats->dropped_blocks += dropped;
+    }
+
+    stats->last = header;
+    stats->blocks++;
+    stats->bytes += length;
+
+    uint32_t payload = length - sizeof(header);
+    int result = is_framed ? output_write(output, &payload, sizeof(payload)) : PICO_OK;
+    return result == PICO_OK ? output_write(output, block + sizeof(header), payload) : result;
+}
+
+int main(int argc, char ** argv)
+{
+    char device_path[64] = "";
+    long block_limit = -1;
+    bool is_framed = false;
+    int option;
+
+    while ((option = getopt(argc, argv, "d:n:f")) != -1)
+    {
+        switch (option)
+        {
+            case 'd':
+                snprintf(device_path, sizeof(device_path), "%s", optarg);
+                break;
+
+            case 'n':
+                block_limit = strtol(optarg, NULL, 0);
+                break;
+
+            case 'f':
+                is_framed = true;
+                break;
+
+            default:
+                fprintf(stderr, "Usage: %s [-d /dev/bus/usb/BBB/DDD] [-n blocks] [-f] output\n", argv[0]);
+                return 2;
+        }
+    }
+
+    if (optind != argc - 1)
+    {
+        fprintf(stderr, "Usage: %s [-d /dev/bus/usb/BBB/DDD] [-n blocks] [-f] output\n", argv[0]);
+        return 2;
+    }
+
+    if (device_path[0] == '\0' && usb_stream_find_device(device_path, sizeof(device_path)) != PICO_OK)
+    {
+        fprintf(stderr, "No device %04x:%04x\n", USB_STREAM_VID, USB_STREAM_PID);
+        return 1;
+    }
+
+    int device = open(device_path, O_RDWR);
+    unsigned int interface = USB_STREAM_INTERFACE;
+
+    if (device < 0 || ioctl(device, USBDEVFS_CLAIMINTERFACE, &interface) != 0)
+    {
+        perror(device_path);
+        return 1;
+    }
+
+    output_file_t output = {open(argv[optind], O_RDWR | O_CREAT | O_TRUNC, 0644), NULL, 0, 0};
+
+    if (output.fd < 0)
+    {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    // No SA_RESTART, so a signal also ends the wait in USBDEVFS_REAPURB.
+    struct sigaction action = {0};
+    action.sa_handler = stop_receiving;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    // Bulk URBs on one endpoint complete in the order they were submitted.
+    static struct usbdevfs_urb urbs[USB_STREAM_URBS];
+    static uint8_t buffers[USB_STREAM_URBS][USB_STREAM_BLOCK_SIZE];
+    int queued = 0;
+
+    for (int i = 0; i < USB_STREAM_URBS; i++)
+    {
+        urbs[i].type = USBDEVFS_URB_TYPE_BULK;
+        urbs[i].endpoint = USB_STREAM_ENDPOINT;
+        urbs[i].buffer = buffers[i];
+        urbs[i].buffer_length = USB_STREAM_BLOCK_SIZE;
+
+        if (ioctl(device, USBDEVFS_SUBMITURB, &urbs[i]) == 0)
+        {
+            queued++;
+        }
+    }
+
+    receive_stats_t stats = {0};
+    uint64_t start = time_us_64();
+    int result = PICO_OK;
+    bool is_discarded = false;
+
+    while (queued > 0 && result == PICO_OK)
+    {
+        struct usbdevfs_urb * urb;
+
+        // The queued reads are cancelled and reaped with -ENOENT.
+        if (!is_receiving && !is_discarded)
+        {
+            for (int i = 0; i < USB_STREAM_URBS; i++)
+            {
+                ioctl(device, USBDEVFS_DISCARDURB, &urbs[i]);
+            }
+
+            is_discarded = true;
+        }
+
+        if (ioctl(device, USBDEVFS_REAPURB, &urb) != 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            perror("USBDEVFS_REAPURB");
+            result = PICO_ERROR_IO;
+            break;
+        }
+
+        queued--;
+
+        if (urb->status == 0 && (block_limit < 0 || stats.blocks < block_limit))
+        {
+            result = receive_block(&output, &stats, urb->buffer, urb->actual_length, is_framed);
+        }
+
+        else if (urb->status != 0 && urb->status != -ENOENT)
+        {
+            fprintf(stderr, "Transfer failed: %s\n", strerror(-urb->status));
+            result = PICO_ERROR_IO;
+        }
+
+        if (block_limit >= 0 && stats.blocks >= block_limit)
+        {
+            is_receiving = false;
+        }
+
+        if (is_receiving && result == PICO_OK && ioctl(device, USBDEVFS_SUBMITURB, urb) == 0)
+        {
+            queued++;
+        }
+    }
+
+    double seconds = (time_us_64() - start) / 1e6;
+    fprintf(stderr, "%u blocks, %llu bytes in %.1f s (%.0f kB/s), %u missing, %u dropped on the Pico\n",
+            stats.blocks, (unsigned long long) stats.bytes, seconds, seconds > 0 ? stats.bytes / seconds / 1000 : 0.0,
+            stats.missing_blocks, stats.dropped_blocks);
+
+    output_close(&output);
+    ioctl(device, USBDEVFS_RELEASEINTERFACE, &interface);
+    close(device);
+    return result != PICO_OK;
+}
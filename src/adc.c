@@ -0,0 +1,159 @@
+#include "PicoLibrary.h"
+
+// With PICO_LIBRARY_INLINE these are defined in PicoLibrary.h instead.
+#ifndef PICO_LIBRARY_INLINE
+
+#pragma region ADC Functions
+
+uint16_t PICO_LIBRARY_HOT(adc_read_gpio_pin_raw)(uint8_t adc_input)
+{
+    // Only the first read of an input leaves RAM for the set-up in flash.
+    if (!(adc_input_init_mask & (1u << adc_input)))
+    {
+        adc_input_init(adc_input);
+    }
+
+    // Select ADC input 0 (GPIO26), input 1 (GPIO27) ....
+    adc_select_input(adc_input);
+
+    return adc_read();
+}
+
+float PICO_LIBRARY_HOT(adc_read_gpio_pin_volts)(uint8_t adc_input)
+{
+    const float conversion_factor = ADC_VOLTS_PER_CODE;
+    return adc_read_gpio_pin_raw(adc_input) * conversion_factor;
+}
+
+void adc_set_temperature_sensor(bool on)
+{
+    if (!is_adc_init)
+    {
+        adc_init();
+        is_adc_init = true;
+    }
+
+    adc_set_temp_sensor_enabled(on);
+}
+
+void PICO_LIBRARY_HOT(adc_select_pin)(uint8_t pin)
+{
+    if (!is_adc_init)
+    {
+        adc_init();
+        is_adc_init = true;
+    }
+
+    adc_select_input(pin);
+}
+
+uint16_t PICO_LIBRARY_HOT(adc_read_selected_raw)()
+{
+    if (!is_adc_init)
+    {
+        adc_init();
+        is_adc_init = true;
+    }
+
+    return adc_read();
+}
+
+float PICO_LIBRARY_HOT(adc_read_selected_volts)()
+{
+    const float conversion_factor = ADC_VOLTS_PER_CODE;
+    return adc_read_selected_raw() * conversion_factor;
+}
+
+#endif
+
+void PICO_LIBRARY_HOT(adc_capture)(uint16_t *buf, size_t count) 
+{
+    if (!is_adc_init)
+    {
+        adc_init();
+        is_adc_init = true;
+    }
+
+    adc_fifo_setup(true, false, 0, false, false);
+    adc_run(true);
+
+    for (size_t i = 0; i < count; i = i + 1)
+    {
+        buf[i] = adc_fifo_get_blocking();
+    }
+
+    adc_run(false);
+    adc_fifo_drain();
+}
+
+void PICO_LIBRARY_HOT(adc_capture_packed)(void * packed, size_t count) 
+{
+    if (!is_adc_init)
+    {
+        adc_init();
+        is_adc_init = true;
+    }
+
+    // Packed eight samples at a time, three words, so the output never needs the room
+    // uint16_t samples would take.
+    uint16_t samples[8] __aligned(4);
+    uint8_t * output = packed;
+
+    adc_fifo_setup(true, false, 0, false, false);
+    adc_run(true);
+
+    for (size_t i = 0; i < count; i = i + 8)
+    {
+        size_t chunk = count - i < 8 ? count - i : 8;
+
+        for (size_t j = 0; j < chunk; j = j + 1)
+        {
+            samples[j] = adc_fifo_get_blocking();
+        }
+
+        output += pack12_block(samples, output, chunk);
+    }
+
+    adc_run(false);
+    adc_fifo_drain();
+}
+
+float acd_read_onboard_temperature(enum temperature_enum temperature, uint8_t pin) 
+{
+    if (!is_adc_init)
+    {
+        adc_init();
+        is_gpio_init = true;
+    }
+
+    /* Initialize hardware AD converter, enable onboard temperature sensor and
+     *   select its channel (do this once for efficiency, but beware that this
+     *   is a global operation). */
+
+    adc_set_temp_sensor_enabled(true);
+    adc_select_input(pin);
+
+    const float conversionFactor = ADC_VOLTS_PER_CODE;
+
+    float adc = (float) adc_read() * conversionFactor;
+    float tempC = 27.0f - (adc - 0.706f) / 0.001721f;
+
+    if (temperature == CELCIUS) 
+    {
+        return tempC;
+    } 
+    
+    else if (temperature == FAHRENHEIT) 
+    {
+        return tempC * 9 / 5 + 32;
+    }
+
+    else if (temperature == KELVIN) 
+    {
+        return tempC + 273.15;
+    }
+
+    return -1.0f;
+}
+
+#pragma endregion
@@ -0,0 +1,127 @@
+#include "adc_oversample.h"
+
+#pragma region ADC Oversampling Functions
+
+uint16_t adc_dnl_table[1 << 12];
+bool is_adc_dnl_table_init = false;
+
+adc_calibration_t adc_calibrations[5] =
+{
+    {0, ADC_CALIBRATION_UNITY},
+    {0, ADC_CALIBRATION_UNITY},
+    {0, ADC_CALIBRATION_UNITY},
+    {0, ADC_CALIBRATION_UNITY},
+    {0, ADC_CALIBRATION_UNITY}
+};
+
+// Maps every code to the centre of its share of the input range, given how wide each
+// code is. widths == NULL uses the datasheet's DNL spikes instead of measured widths.
+static void adc_dnl_table_build(const uint32_t * widths, uint16_t * table)
+{
+    uint64_t total = 0;
+
+    for (uint32_t code = 0; code < (1 << 12); code++)
+    {
+        total += widths != NULL ? widths[code] : ((code & 0x3ff) == 0x200 ? 1 + ADC_DNL_SPIKE_LSB : 1);
+    }
+
+    if (total == 0)
+    {
+        return;
+    }
+
+    uint64_t position = 0;
+
+    for (uint32_t code = 0; code < (1 << 12); code++)
+    {
+        uint32_t width = widths != NULL ? widths[code] : ((code & 0x3ff) == 0x200 ? 1 + ADC_DNL_SPIKE_LSB : 1);
+        uint64_t centre = ((2 * position + width) << 16) / (2 * total);
+        table[code] = centre > UINT16_MAX ? UINT16_MAX : centre;
+        position += width;
+    }
+}
+
+void adc_dnl_table_default(uint16_t * table)
+{
+    adc_dnl_table_build(NULL, table);
+}
+
+// Code density test: with a slow ramp or triangle covering the whole range, the number of
+// hits on a code is proportional to its width.
+void adc_dnl_table_from_histogram(const uint32_t * histogram, uint16_t * table)
+{
+    adc_dnl_table_build(histogram, table);
+}
+
+void adc_dnl_table_set(const uint16_t * table)
+{
+    memcpy(adc_dnl_table, table, sizeof(adc_dnl_table));
+    is_adc_dnl_table_init = true;
+}
+
+void adc_calibration_set(uint8_t adc_input, int32_t offset, uint32_t gain)
+{
+    if (adc_input < 5)
+    {
+        adc_calibrations[adc_input].offset = offset;
+        adc_calibrations[adc_input].gain = gain;
+    }
+}
+
+// Takes two uncalibrated results and the values they should have been, on the same
+// 16-bit scale, for example from two reference voltages.
+int adc_calibration_two_point(uint8_t adc_input, uint16_t measured_low, uint16_t actual_low, uint16_t measured_high, uint16_t actual_high)
+{
+    if (adc_input >= 5 || measured_high <= measured_low || actual_high <= actual_low)
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    // Both rounded, truncating them costs a few units at the far end of the scale.
+    uint32_t span = measured_high - measured_low;
+    uint32_t gain = (((uint32_t) (actual_high - actual_low) << 16) + span / 2) / span;
+    int32_t offset = measured_low - (int32_t) ((((int64_t) actual_low << 16) + gain / 2) / gain);
+
+    adc_calibration_set(adc_input, offset, gain);
+    return PICO_OK;
+}
+
+void adc_oversample_init()
+{
+    if (!is_adc_dnl_table_init)
+    {
+        adc_dnl_table_default(adc_dnl_table);
+        is_adc_dnl_table_init = true;
+    }
+}
+
+void PICO_LIBRARY_HOT(adc_oversample_decimate_block)(const uint16_t * raw, uint16_t * output, size_t output_count, uint8_t bits, uint8_t adc_input)
+{
+    adc_oversample_init();
+
+    uint8_t shift = 2 * (bits - 12);
+    uint32_t samples = 1u << shift;
+    const adc_calibration_t calibration = adc_calibrations[adc_input];
+
+    for (size_t i = 0; i < output_count; i++)
+    {
+        // At most 256 samples of 16 bits, the sum fits easily.
+        uint32_t sum = 0;
+
+        for (uint32_t j = 0; j < samples; j++)
+        {
+            sum += adc_dnl_table[*raw++ & 0xfff];
+        }
+
+        int32_t mean = (sum + (samples >> 1)) >> shift;
+        int32_t value = ((int64_t) (mean - calibration.offset) * calibration.gain) >> 16;
+        output[i] = value < 0 ? 0 : value > UINT16_MAX ? UINT16_MAX : value;
+    }
+}
+
+float adc_oversample_volts(uint16_t value)
+{
+    return value * (3.3f / 65536);
+}
+
+#pragma endregion
@@ -0,0 +1,32 @@
+#ifndef PICO_LIBRARY_ADC_OVERSAMPLE_H_
+#define PICO_LIBRARY_ADC_OVERSAMPLE_H_
+
+#include "portable.h"
+
+// ADC oversampling functions
+// Oversampled reads at 13 to 16 bits: 4^(bits - 12) conversions are averaged for every
+// result. Each conversion first goes through a DNL table that maps its code to the centre
+// of its real input range, then the average gets the channel's offset and gain. Results
+// are always on a 16-bit full scale. Integer only, whole blocks at a time. The default
+// table is built on first use, or by adc_oversample_init ahead of time.
+#define ADC_OVERSAMPLE_BLOCK 1024 // Raw samples per DMA buffer, a multiple of 4^4
+#define ADC_OVERSAMPLE_MAX_BITS 16
+#define ADC_DNL_SPIKE_LSB 8 // Extra width of codes 512, 1536, 2560 and 3584, from the datasheet's DNL plot
+#define ADC_CALIBRATION_UNITY 65536
+
+typedef struct
+{
+    int32_t offset; // 16-bit full scale units, subtracted before the gain
+    uint32_t gain;  // Q16, ADC_CALIBRATION_UNITY leaves the result unchanged
+} adc_calibration_t;
+
+void adc_oversample_init();
+void adc_dnl_table_default(uint16_t * table);
+void adc_dnl_table_from_histogram(const uint32_t * histogram, uint16_t * table);
+void adc_dnl_table_set(const uint16_t * table);
+void adc_calibration_set(uint8_t adc_input, int32_t offset, uint32_t gain);
+int adc_calibration_two_point(uint8_t adc_input, uint16_t measured_low, uint16_t actual_low, uint16_t measured_high, uint16_t actual_high);
+void PICO_LIBRARY_HOT(adc_oversample_decimate_block)(const uint16_t * raw, uint16_t * output, size_t output_count, uint8_t bits, uint8_t adc_input);
+float adc_oversample_volts(uint16_t value);
+
+#endif
@@ -0,0 +1,98 @@
+#include "PicoLibrary.h"
+
+#pragma region ADC Oversampling Device Functions
+
+_Static_assert(2 * ADC_OVERSAMPLE_BLOCK * sizeof(uint16_t) <= SAMPLE_POOL_BLOCK_SIZE, "Both raw buffers must fit in a sample pool block");
+
+int adc_oversample_read_block(uint8_t adc_input, uint8_t bits, uint32_t sample_rate, uint16_t * output, size_t count)
+{
+    // The ADC takes 96 cycles of its 48 MHz clock per conversion, 500 ksps at most.
+    if (adc_input >= 5 || bits < 12 || bits > ADC_OVERSAMPLE_MAX_BITS || sample_rate == 0 || sample_rate > 500000)
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    // Both raw buffers share one sample pool block for as long as the read takes.
+    block_pool_t * pool = sample_pool_get();
+    uint16_t * block = pool != NULL ? block_pool_alloc(pool) : NULL;
+
+    if (block == NULL)
+    {
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+
+    uint16_t * raw[2] = {block, block + ADC_OVERSAMPLE_BLOCK};
+    size_t outputs_per_block = ADC_OVERSAMPLE_BLOCK >> (2 * (bits - 12));
+    int channels[2];
+
+    // The DNL table takes several milliseconds to build, far longer than a block, so it
+    // has to be ready before the ADC runs.
+    adc_oversample_init();
+
+    adc_input_init(adc_input);
+    adc_select_input(adc_input);
+    adc_set_clkdiv(48000000.0f / sample_rate - 1);
+    adc_fifo_setup(true, true, 1, false, false);
+
+    for (int i = 0; i < 2; i++)
+    {
+        channels[i] = dma_claim_unused_channel(true);
+    }
+
+    // The channels fill the buffers alternately, polled rather than interrupting.
+    dma_ping_pong_configure(channels, DMA_SIZE_16, DREQ_ADC, &adc_hw->fifo, (void * [2]) {raw[0], raw[1]}, ADC_OVERSAMPLE_BLOCK, false, -1);
+
+    for (int i = 0; i < 2; i++)
+    {
+        dma_channel_acknowledge_irq0(channels[i]);
+    }
+
+    dma_channel_start(channels[0]);
+    adc_run(true);
+
+    size_t done = 0;
+    int next = 0;
+    int result = PICO_OK;
+
+    while (done < count)
+    {
+        // The raw interrupt status is set on completion whether or not the interrupt is enabled.
+        while (!(dma_hw->intr & (1u << channels[next])))
+        {
+            tight_loop_contents();
+        }
+
+        dma_channel_acknowledge_irq0(channels[next]);
+
+        // If the other channel has finished as well, it has already chained back to this
+        // one before it was rewound, and this one is writing past its buffer. Stopped at
+        // once, rather than let it run over the rest of the pool.
+        if (dma_hw->intr & (1u << channels[next ^ 1]))
+        {
+            result = PICO_ERROR_IO;
+            break;
+        }
+
+        // Rewind before the other channel chains back to this one, a block is plenty of
+        // time to process this buffer.
+        dma_channel_set_write_addr(channels[next], raw[next], false);
+
+        size_t outputs = count - done < outputs_per_block ? count - done : outputs_per_block;
+        adc_oversample_decimate_block(raw[next], output + done, outputs, bits, adc_input);
+
+        done += outputs;
+        next ^= 1;
+    }
+
+    adc_run(false);
+    dma_ping_pong_stop(channels, 0);
+
+    // Back to single conversions for adc_read.
+    adc_fifo_drain();
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_set_clkdiv(0);
+    block_pool_release(pool, block);
+    return result;
+}
+
+#pragma endregion
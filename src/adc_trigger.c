@@ -0,0 +1,317 @@
+#include "PicoLibrary.h"
+
+#pragma region ADC Trigger Functions
+
+// A sample is in a range when low <= sample <= low + span, or outside it when is_outside.
+typedef struct
+{
+    uint16_t low;
+    uint16_t span;
+    bool is_outside;
+} adc_trigger_range_t;
+
+// Not from the sample pool: the DMA wrap needs one region aligned to its 16 KB size, and
+// the pool's arena only bumps, so that alignment could waste up to as much again for good.
+uint16_t adc_trigger_ring[ADC_TRIGGER_RING_SAMPLES] __aligned(1 << ADC_TRIGGER_RING_BITS);
+int adc_trigger_channel = -1;
+adc_trigger_config_t adc_trigger_config;
+adc_trigger_stats_t adc_trigger_stats;
+adc_trigger_range_t adc_trigger_fire_range;
+adc_trigger_range_t adc_trigger_arm_range;
+uint32_t adc_trigger_holdoff_samples = 0;
+bool is_adc_trigger_armed = false;
+
+// Free running sample counts since adc_trigger_start, taken modulo the ring size to index the ring.
+uint32_t adc_trigger_base = 0;
+uint32_t adc_trigger_scan = 0;
+
+static inline uint32_t adc_trigger_head()
+{
+    // The channel counts down from UINT32_MAX.
+    return adc_trigger_base + (UINT32_MAX - dma_channel_hw_addr(adc_trigger_channel)->transfer_count);
+}
+
+static inline bool adc_trigger_is_level_mode()
+{
+    return adc_trigger_config.mode == ADC_TRIGGER_ABOVE || adc_trigger_config.mode == ADC_TRIGGER_BELOW;
+}
+
+static void adc_trigger_set_range(adc_trigger_range_t * range, int32_t low, int32_t high, bool is_outside)
+{
+    // Clamped to the 12-bit codes, a side clamped away can never be outside.
+    low = low < 0 ? 0 : low;
+    high = high > 4095 ? 4095 : high;
+
+    range->low = low;
+    range->span = high - low;
+    range->is_outside = is_outside;
+}
+
+// Returns the index of the sample that fired the trigger, or count if none did.
+static size_t PICO_LIBRARY_HOT(adc_trigger_scan_block)(const uint16_t * samples, size_t count)
+{
+    size_t i = 0;
+
+    while (i < count)
+    {
+        if (!is_adc_trigger_armed)
+        {
+            const adc_trigger_range_t range = adc_trigger_arm_range;
+
+            for (; i < count; i++)
+            {
+                // Unsigned, so a sample below low wraps to a large value and is outside.
+                if (((uint32_t) samples[i] - range.low <= range.span) != range.is_outside)
+                {
+                    is_adc_trigger_armed = true;
+                    i++;
+                    break;
+                }
+            }
+        }
+
+        else
+        {
+            const adc_trigger_range_t range = adc_trigger_fire_range;
+
+            for (; i < count; i++)
+            {
+                if (((uint32_t) samples[i] - range.low <= range.span) != range.is_outside)
+                {
+                    is_adc_trigger_armed = false;
+                    return i;
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+int adc_trigger_start(uint8_t adc_input, uint32_t sample_rate, const adc_trigger_config_t * config)
+{
+    // The ADC takes 96 cycles of its 48 MHz clock per conversion, 500 ksps at most.
+    if (adc_input > 4 || sample_rate == 0 || sample_rate > 500000 || config->post_samples == 0 ||
+        config->pre_samples > ADC_TRIGGER_MAX_WINDOW || config->post_samples > ADC_TRIGGER_MAX_WINDOW - config->pre_samples)
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    if (adc_trigger_channel >= 0)
+    {
+        return PICO_ERROR_NOT_PERMITTED;
+    }
+
+    int32_t level = config->level;
+    int32_t level_high = config->level_high;
+    int32_t hysteresis = config->hysteresis;
+
+    if (level > 4095 || ((config->mode == ADC_TRIGGER_ENTER_WINDOW || config->mode == ADC_TRIGGER_LEAVE_WINDOW) && (level_high > 4095 || level_high < level)))
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    // Edge modes arm once the signal is more than the hysteresis the other side of the level,
+    // window modes once it is that far outside or inside the window.
+    switch (config->mode)
+    {
+        case ADC_TRIGGER_ABOVE:
+        case ADC_TRIGGER_RISING:
+        {
+            if (config->mode == ADC_TRIGGER_RISING && level <= hysteresis)
+            {
+                return PICO_ERROR_INVALID_ARG;
+            }
+
+            adc_trigger_set_range(&adc_trigger_fire_range, level, 4095, false);
+            adc_trigger_set_range(&adc_trigger_arm_range, 0, level - 1 - hysteresis, false);
+            break;
+        }
+
+        case ADC_TRIGGER_BELOW:
+        case ADC_TRIGGER_FALLING:
+        {
+            if (config->mode == ADC_TRIGGER_FALLING && level + hysteresis >= 4095)
+            {
+                return PICO_ERROR_INVALID_ARG;
+            }
+
+            adc_trigger_set_range(&adc_trigger_fire_range, 0, level, false);
+            adc_trigger_set_range(&adc_trigger_arm_range, level + 1 + hysteresis, 4095, false);
+            break;
+        }
+
+        case ADC_TRIGGER_ENTER_WINDOW:
+        {
+            adc_trigger_set_range(&adc_trigger_fire_range, level, level_high, false);
+            adc_trigger_set_range(&adc_trigger_arm_range, level - hysteresis, level_high + hysteresis, true);
+            break;
+        }
+
+        case ADC_TRIGGER_LEAVE_WINDOW:
+        {
+            if (level + hysteresis > level_high - hysteresis)
+            {
+                return PICO_ERROR_INVALID_ARG;
+            }
+
+            adc_trigger_set_range(&adc_trigger_fire_range, level, level_high, true);
+            adc_trigger_set_range(&adc_trigger_arm_range, level + hysteresis, level_high - hysteresis, false);
+            break;
+        }
+
+        default:
+            return PICO_ERROR_INVALID_ARG;
+    }
+
+    adc_trigger_config = *config;
+    adc_trigger_stats = (adc_trigger_stats_t) {0};
+    adc_trigger_stats.sample_rate = sample_rate;
+    adc_trigger_holdoff_samples = (uint64_t) config->holdoff_us * sample_rate / 1000000;
+    is_adc_trigger_armed = adc_trigger_is_level_mode();
+
+    // The first trigger needs a full history behind it.
+    adc_trigger_base = 0;
+    adc_trigger_scan = config->pre_samples;
+
+    adc_input_init(adc_input);
+    adc_select_input(adc_input);
+    adc_set_clkdiv(48000000.0f / sample_rate - 1);
+    adc_fifo_setup(true, true, 1, false, false);
+
+    // The ring wraps in hardware, so the channel never needs the CPU.
+    adc_trigger_channel = dma_claim_unused_channel(true);
+
+    dma_channel_config cfg = dma_channel_get_default_config(adc_trigger_channel);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_ring(&cfg, true, ADC_TRIGGER_RING_BITS);
+    channel_config_set_dreq(&cfg, DREQ_ADC);
+    dma_channel_configure(adc_trigger_channel, &cfg, adc_trigger_ring, &adc_hw->fifo, UINT32_MAX, true);
+
+    adc_run(true);
+    return PICO_OK;
+}
+
+int adc_trigger_wait(uint16_t * buffer, uint32_t timeout_us)
+{
+    if (adc_trigger_channel < 0)
+    {
+        return PICO_ERROR_NOT_PERMITTED;
+    }
+
+    absolute_time_t until = make_timeout_time_us(timeout_us);
+    const uint32_t pre_samples = adc_trigger_config.pre_samples;
+    const uint32_t window = pre_samples + adc_trigger_config.post_samples;
+
+    while (true)
+    {
+        // Carry on once the 4G sample transfer count runs out, from the same ring position.
+        if (!dma_channel_is_busy(adc_trigger_channel))
+        {
+            adc_trigger_base += UINT32_MAX;
+            dma_channel_set_trans_count(adc_trigger_channel, UINT32_MAX, true);
+        }
+
+        uint32_t head = adc_trigger_head();
+
+        // The DMA has lapped the scan, start again from the newest samples. The trigger has to
+        // arm again as the samples in between are gone.
+        if ((int32_t) (head - adc_trigger_scan) > ADC_TRIGGER_RING_SAMPLES - ADC_TRIGGER_BLOCK)
+        {
+            adc_trigger_stats.overruns++;
+            adc_trigger_scan = head;
+            is_adc_trigger_armed = adc_trigger_is_level_mode();
+        }
+
+        bool is_triggered = false;
+        uint32_t trigger = 0;
+
+        // Whole blocks only, they never cross the end of the ring unless a holdoff left the
+        // scan part way through one.
+        while ((int32_t) (head - adc_trigger_scan) >= ADC_TRIGGER_BLOCK)
+        {
+            uint32_t index = adc_trigger_scan % ADC_TRIGGER_RING_SAMPLES;
+            uint32_t count = ADC_TRIGGER_RING_SAMPLES - index < ADC_TRIGGER_BLOCK ? ADC_TRIGGER_RING_SAMPLES - index : ADC_TRIGGER_BLOCK;
+            size_t fired = adc_trigger_scan_block(adc_trigger_ring + index, count);
+            adc_trigger_stats.blocks_scanned++;
+
+            if (fired < count)
+            {
+                trigger = adc_trigger_scan + fired;
+                adc_trigger_scan = trigger + 1;
+                is_triggered = true;
+                break;
+            }
+
+            adc_trigger_scan += count;
+        }
+
+        if (!is_triggered)
+        {
+            if (time_reached(until))
+            {
+                return PICO_ERROR_TIMEOUT;
+            }
+
+            tight_loop_contents();
+            continue;
+        }
+
+        // Only a few ms at most, ADC_TRIGGER_MAX_WINDOW samples at 500 ksps.
+        uint32_t start = trigger - pre_samples;
+
+        while ((int32_t) (adc_trigger_head() - start) < (int32_t) window)
+        {
+            tight_loop_contents();
+        }
+
+        uint32_t index = start % ADC_TRIGGER_RING_SAMPLES;
+        uint32_t first = window < ADC_TRIGGER_RING_SAMPLES - index ? window : ADC_TRIGGER_RING_SAMPLES - index;
+        memcpy(buffer, adc_trigger_ring + index, first * 2);
+        memcpy(buffer + first, adc_trigger_ring, (window - first) * 2);
+
+        // Overwritten while it was copied, it is not worth returning.
+        if (adc_trigger_head() - start > ADC_TRIGGER_RING_SAMPLES)
+        {
+            adc_trigger_stats.overruns++;
+            is_adc_trigger_armed = adc_trigger_is_level_mode();
+            continue;
+        }
+
+        // Re-arm after this window or the holdoff, whichever is later. Edge and window modes
+        // still have to see a crossing.
+        uint32_t post_samples = adc_trigger_config.post_samples;
+        adc_trigger_scan = trigger + (adc_trigger_holdoff_samples > post_samples ? adc_trigger_holdoff_samples : post_samples);
+        is_adc_trigger_armed = adc_trigger_is_level_mode();
+        adc_trigger_stats.triggers++;
+        adc_trigger_stats.trigger_position = trigger;
+        return window;
+    }
+}
+
+void adc_trigger_stop()
+{
+    if (adc_trigger_channel < 0)
+    {
+        return;
+    }
+
+    adc_run(false);
+    dma_channel_abort(adc_trigger_channel);
+    dma_channel_unclaim(adc_trigger_channel);
+    adc_trigger_channel = -1;
+
+    // Back to single conversions for adc_read.
+    adc_fifo_drain();
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_set_clkdiv(0);
+}
+
+void adc_trigger_get_stats(adc_trigger_stats_t * stats)
+{
+    *stats = adc_trigger_stats;
+}
+
+#pragma endregion
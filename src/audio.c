@@ -0,0 +1,358 @@
+#include "PicoLibrary.h"
+
+#pragma region Audio Functions
+
+_Static_assert(2 * AUDIO_BLOCK_SIZE * sizeof(uint16_t) <= SAMPLE_POOL_BLOCK_SIZE, "Both buffers must fit in a sample pool block");
+
+uint16_t * audio_buffers[2]; // Halves of one sample pool block while running
+int audio_dma_channels[2] = {-1, -1};
+volatile uint8_t audio_ready_mask = 0;
+volatile uint32_t audio_dropped_blocks = 0;
+
+audio_dc_filter_t audio_dc_filter;
+audio_fir_t audio_fir;
+audio_stats_t audio_stats;
+spin_lock_t * audio_stats_lock = NULL;
+void (*audio_block_callback)(int16_t * samples, size_t count, const audio_stats_t * stats);
+
+static inline int16_t saturate_int16(int32_t value)
+{
+    if (value > INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+
+    else if (value < INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+
+    return value;
+}
+
+void PICO_LIBRARY_HOT(audio_convert_block)(int16_t * samples, size_t count)
+{
+    const uint16_t * raw = (const uint16_t *) samples;
+
+    // 12-bit unsigned ADC codes centred on mid-scale become Q15.
+    for (size_t i = 0; i < count; i++)
+    {
+        samples[i] = (int16_t) (((int32_t) raw[i] - 2048) << 4);
+    }
+}
+
+void audio_dc_filter_init(audio_dc_filter_t * filter)
+{
+    filter->previous_input = 0;
+    filter->previous_output = 0;
+    filter->pole = AUDIO_DC_POLE;
+}
+
+void PICO_LIBRARY_HOT(audio_dc_remove_block)(audio_dc_filter_t * filter, int16_t * samples, size_t count)
+{
+    int32_t previous_input = filter->previous_input;
+    int32_t previous_output = filter->previous_output;
+
+    // y[n] = x[n] - x[n - 1] + pole * y[n - 1]
+    for (size_t i = 0; i < count; i++)
+    {
+        int32_t input = samples[i];
+        int32_t output = input - previous_input + ((filter->pole * previous_output) >> 15);
+
+        previous_input = input;
+        previous_output = saturate_int16(output);
+        samples[i] = previous_output;
+    }
+
+    filter->previous_input = previous_input;
+    filter->previous_output = previous_output;
+}
+
+void audio_fir_init(audio_fir_t * fir, uint8_t decimation)
+{
+    // Windowed-sinc low pass just under the decimated Nyquist frequency.
+    const float cutoff = 0.45f / decimation;
+    const float middle = (AUDIO_FIR_TAPS - 1) / 2.0f;
+    float taps[AUDIO_FIR_TAPS];
+    float sum = 0;
+
+    for (int i = 0; i < AUDIO_FIR_TAPS; i++)
+    {
+        float x = i - middle;
+        float sinc = x == 0 ? 2 * cutoff : sinf(2 * M_PI * cutoff * x) / (M_PI * x);
+        float window = 0.54f - 0.46f * cosf(2 * M_PI * i / (AUDIO_FIR_TAPS - 1));
+
+        taps[i] = sinc * window;
+        sum += taps[i];
+    }
+
+    for (int i = 0; i < AUDIO_FIR_TAPS; i++)
+    {
+        fir->coefficients[i] = (int16_t) lroundf(taps[i] / sum * INT16_MAX);
+    }
+
+    for (int i = 0; i < AUDIO_FIR_TAPS * 2; i++)
+    {
+        fir->history[i] = 0;
+    }
+
+    fir->index = 0;
+    fir->phase = 0;
+    fir->decimation = decimation;
+}
+
+size_t PICO_LIBRARY_HOT(audio_fir_decimate_block)(audio_fir_t * fir, int16_t * samples, size_t count)
+{
+    size_t output_count = 0;
+
+    // Outputs are written behind the read position, so the block can be filtered in place.
+    for (size_t i = 0; i < count; i++)
+    {
+        // Every sample is stored twice so the taps are always contiguous, oldest first.
+        fir->history[fir->index] = samples[i];
+        fir->history[fir->index + AUDIO_FIR_TAPS] = samples[i];
+
+        if (++fir->index == AUDIO_FIR_TAPS)
+        {
+            fir->index = 0;
+        }
+
+        if (++fir->phase == fir->decimation)
+        {
+            const int16_t * history = &fir->history[fir->index];
+            int32_t sum = 0;
+
+            fir->phase = 0;
+
+            for (int tap = 0; tap < AUDIO_FIR_TAPS; tap++)
+            {
+                sum += history[tap] * fir->coefficients[tap];
+            }
+
+            samples[output_count++] = saturate_int16(sum >> 15);
+        }
+    }
+
+    return output_count;
+}
+
+void PICO_LIBRARY_HOT(audio_measure_block)(const int16_t * samples, size_t count, audio_stats_t * stats)
+{
+    uint64_t sum_of_squares = 0;
+    int32_t peak = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        int32_t sample = samples[i];
+        int32_t magnitude = sample < 0 ? -sample : sample;
+
+        sum_of_squares += sample * sample;
+
+        if (magnitude > peak)
+        {
+            peak = magnitude;
+        }
+    }
+
+    // Only the final square root and logarithm are done in floating point, once per block.
+    float rms = sqrtf((float) sum_of_squares / count);
+
+    stats->rms = (uint16_t) rms;
+    stats->peak = (uint16_t) peak;
+    stats->level_db = rms > 0 ? 20 * log10f(rms / 32768.0f) : AUDIO_SILENCE_DB;
+}
+
+static void PICO_LIBRARY_HOT(audio_dma_handler)()
+{
+    for (int i = 0; i < 2; i++)
+    {
+        uint channel = audio_dma_channels[i];
+
+        if (dma_channel_get_irq0_status(channel))
+        {
+            dma_channel_acknowledge_irq0(channel);
+
+            // The other channel is now filling its buffer, rewind this one for when it is chained back to.
+            dma_channel_set_write_addr(channel, audio_buffers[i], false);
+
+            if (audio_ready_mask & (1 << i))
+            {
+                audio_dropped_blocks++;
+            }
+
+            audio_ready_mask |= 1 << i;
+        }
+    }
+}
+
+static void PICO_LIBRARY_HOT(audio_process_block)(int16_t * samples)
+{
+    audio_stats_t stats;
+    uint32_t start = cycle_counter_get();
+
+    audio_convert_block(samples, AUDIO_BLOCK_SIZE);
+    stats.convert_cycles = cycle_counter_elapsed(start);
+
+    start = cycle_counter_get();
+    audio_dc_remove_block(&audio_dc_filter, samples, AUDIO_BLOCK_SIZE);
+    stats.dc_cycles = cycle_counter_elapsed(start);
+
+    size_t count = AUDIO_BLOCK_SIZE;
+    start = cycle_counter_get();
+
+    if (audio_fir.decimation > 1)
+    {
+        count = audio_fir_decimate_block(&audio_fir, samples, AUDIO_BLOCK_SIZE);
+    }
+
+    stats.fir_cycles = cycle_counter_elapsed(start);
+
+    start = cycle_counter_get();
+    audio_measure_block(samples, count, &stats);
+    stats.measure_cycles = cycle_counter_elapsed(start);
+
+    uint32_t save = spin_lock_blocking(audio_stats_lock);
+    stats.block_count = audio_stats.block_count + 1;
+    stats.dropped_blocks = audio_dropped_blocks;
+    stats.sample_rate = audio_stats.sample_rate;
+    stats.output_count = count;
+    audio_stats = stats;
+    spin_unlock(audio_stats_lock, save);
+
+    if (audio_block_callback)
+    {
+        audio_block_callback(samples, count, &stats);
+    }
+}
+
+static void audio_core1_entry()
+{
+    cycle_counter_start();
+
+    // Lets flash_log park this core while flash is erased or programmed.
+    flash_safe_execute_core_init();
+
+    // Handle the DMA interrupt here so block processing never runs on core0. DMA_IRQ_0 is
+    // this core's alone, the DMA_IRQ_1 handlers of the other subsystems run on core0.
+    irq_add_shared_handler(DMA_IRQ_0, audio_dma_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    dma_channel_start(audio_dma_channels[0]);
+    adc_run(true);
+
+    uint8_t next = 0;
+
+    while (true)
+    {
+        while (!(audio_ready_mask & (1 << next)))
+        {
+            tight_loop_contents();
+        }
+
+        audio_process_block((int16_t *) audio_buffers[next]);
+
+        uint32_t save = save_and_disable_interrupts();
+        audio_ready_mask &= ~(1 << next);
+        restore_interrupts(save);
+
+        next ^= 1;
+    }
+}
+
+int audio_start(uint8_t adc_input, uint32_t sample_rate, uint8_t decimation, void (*block_callback)(int16_t * samples, size_t count, const audio_stats_t * stats))
+{
+    if (decimation == 0 || decimation > AUDIO_MAX_DECIMATION || AUDIO_BLOCK_SIZE % decimation != 0)
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    if (audio_dma_channels[0] >= 0)
+    {
+        return PICO_ERROR_NOT_PERMITTED;
+    }
+
+    block_pool_t * pool = sample_pool_get();
+    uint16_t * block = pool != NULL ? block_pool_alloc(pool) : NULL;
+
+    if (block == NULL)
+    {
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+
+    audio_buffers[0] = block;
+    audio_buffers[1] = block + AUDIO_BLOCK_SIZE;
+
+    // The ADC takes 96 cycles of its 48 MHz clock per conversion, 500 ksps at most.
+    if (sample_rate == 0 || sample_rate > 500000)
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    adc_input_init(adc_input);
+    adc_select_input(adc_input);
+    adc_set_clkdiv(48000000.0f / sample_rate - 1);
+    adc_fifo_setup(true, true, 1, false, false);
+
+    audio_dc_filter_init(&audio_dc_filter);
+    audio_fir_init(&audio_fir, decimation);
+
+    // Claimed once and kept, like the sample pool.
+    if (audio_stats_lock == NULL)
+    {
+        audio_stats_lock = spin_lock_init(spin_lock_claim_unused(true));
+    }
+
+    audio_ready_mask = 0;
+    audio_dropped_blocks = 0;
+    audio_stats = (audio_stats_t) {0};
+    audio_stats.sample_rate = sample_rate / decimation;
+    audio_block_callback = block_callback;
+
+    for (int i = 0; i < 2; i++)
+    {
+        audio_dma_channels[i] = dma_claim_unused_channel(true);
+    }
+
+    // The channels fill the buffers alternately.
+    dma_ping_pong_configure(audio_dma_channels, DMA_SIZE_16, DREQ_ADC, &adc_hw->fifo, (void * [2]) {audio_buffers[0], audio_buffers[1]}, AUDIO_BLOCK_SIZE, false, 0);
+
+    multicore_launch_core1(audio_core1_entry);
+    return PICO_OK;
+}
+
+void audio_stop()
+{
+    if (audio_dma_channels[0] < 0)
+    {
+        return;
+    }
+
+    // Core1 goes first so nothing is processing a block when the channels are released.
+    multicore_reset_core1();
+
+    // Core1 may have been reset holding the stats lock.
+    spin_unlock_unsafe(audio_stats_lock);
+    adc_run(false);
+    dma_ping_pong_stop(audio_dma_channels, 0);
+
+    irq_remove_handler(DMA_IRQ_0, audio_dma_handler);
+    adc_fifo_drain();
+    block_pool_release(sample_pool_get(), audio_buffers[0]);
+}
+
+bool audio_get_stats(audio_stats_t * stats)
+{
+    if (audio_stats_lock == NULL)
+    {
+        return false;
+    }
+
+    uint32_t save = spin_lock_blocking(audio_stats_lock);
+    bool is_new = audio_stats.block_count != stats->block_count;
+    *stats = audio_stats;
+    spin_unlock(audio_stats_lock, save);
+
+    return is_new;
+}
+
+#pragma endregion
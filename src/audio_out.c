@@ -0,0 +1,347 @@
+#include "PicoLibrary.h"
+#include "hardware/pwm.h"
+
+#pragma region Audio Output Functions
+
+typedef struct
+{
+    const void * samples;
+    size_t count;
+    uint32_t step;          // Q16.16 source samples per output sample
+    uint32_t index;
+    uint32_t fraction;      // Q16
+    bool is_adc;
+    bool is_looping;
+    volatile bool is_playing;
+} audio_out_source_t;
+
+_Static_assert(2 * AUDIO_OUT_BLOCK_SIZE * sizeof(uint16_t) <= SAMPLE_POOL_BLOCK_SIZE, "Both buffers must fit in a sample pool block");
+
+uint16_t * audio_out_buffers[2]; // Halves of one sample pool block while playing
+int audio_out_dma_channels[2] = {-1, -1};
+int audio_out_timer = -1;
+uint audio_out_slice;
+volatile int32_t audio_out_volume = AUDIO_OUT_VOLUME_MAX;
+audio_out_source_t audio_out_source;
+audio_out_stats_t audio_out_stats;
+
+static inline int32_t audio_out_sample(const audio_out_source_t * source, uint32_t index)
+{
+    // 12-bit unsigned ADC codes centred on mid-scale become Q15, as in audio_convert_block.
+    if (source->is_adc)
+    {
+        return ((int32_t) ((const uint16_t *) source->samples)[index] - 2048) << 4;
+    }
+
+    return ((const int16_t *) source->samples)[index];
+}
+
+void PICO_LIBRARY_HOT(audio_out_render_block)(uint16_t * levels, size_t count)
+{
+    audio_out_source_t * source = &audio_out_source;
+    int32_t volume = audio_out_volume;
+    size_t i = 0;
+
+    if (source->is_playing)
+    {
+        uint32_t index = source->index;
+        uint32_t fraction = source->fraction;
+
+        for (; i < count; i++)
+        {
+            uint32_t next = index + 1;
+
+            if (next >= source->count)
+            {
+                next = source->is_looping ? 0 : index;
+            }
+
+            // The difference needs 17 bits, so the fraction drops to Q15 to keep the product
+            // in 32.
+            int32_t a = audio_out_sample(source, index);
+            int32_t b = audio_out_sample(source, next);
+            int32_t sample = a + (((b - a) * (int32_t) (fraction >> 1)) >> 15);
+
+            sample = (sample * volume) >> 15;
+            levels[i] = ((uint32_t) (sample + 32768) * (AUDIO_OUT_PWM_WRAP + 1)) >> 16;
+
+            fraction += source->step;
+            index += fraction >> 16;
+            fraction &= 0xFFFF;
+
+            if (index >= source->count)
+            {
+                if (source->is_looping)
+                {
+                    index %= source->count;
+                }
+
+                else
+                {
+                    source->is_playing = false;
+                    i++;
+                    break;
+                }
+            }
+        }
+
+        source->index = index;
+        source->fraction = fraction;
+    }
+
+    // Mid-scale is silence once the filter removes the DC.
+    for (; i < count; i++)
+    {
+        levels[i] = (AUDIO_OUT_PWM_WRAP + 1) / 2;
+    }
+}
+
+static void PICO_LIBRARY_HOT(audio_out_dma_handler)()
+{
+    for (int i = 0; i < 2; i++)
+    {
+        int channel = audio_out_dma_channels[i];
+
+        if (channel < 0 || !dma_channel_get_irq1_status(channel))
+        {
+            continue;
+        }
+
+        dma_channel_acknowledge_irq1(channel);
+
+        // The other channel is playing its buffer now, so this one has a whole block of
+        // time to render and rewind before it is chained to again.
+        uint32_t start = time_us_32();
+        audio_out_render_block(audio_out_buffers[i], AUDIO_OUT_BLOCK_SIZE);
+        dma_channel_set_read_addr(channel, audio_out_buffers[i], false);
+
+        audio_out_stats.render_us = time_us_32() - start;
+        audio_out_stats.blocks++;
+    }
+}
+
+// Keeps x / y if it is a valid timer fraction closer to sample_rate than the best so far.
+// Errors are in clk_sys * samples per second, scaled by y, and compared without division.
+static void audio_out_try_fraction(uint64_t clock, uint32_t sample_rate, uint64_t x, uint64_t y, uint32_t * best_x, uint32_t * best_y, uint64_t * best_error)
+{
+    if (x == 0 || x > y || y > UINT16_MAX)
+    {
+        return;
+    }
+
+    uint64_t product = x * clock;
+    uint64_t target = (uint64_t) sample_rate * y;
+    uint64_t error = product > target ? product - target : target - product;
+
+    if (*best_error == UINT64_MAX || error * *best_y < *best_error * y)
+    {
+        *best_x = x;
+        *best_y = y;
+        *best_error = error;
+    }
+}
+
+// The timer runs at clk_sys * x / y, with both 16 bits and x <= y. The closest fraction
+// is a convergent of sample_rate / clk_sys's continued fraction, or the last one before y
+// passes 16 bits, so only those are tried, a few dozen at most. Returns the rate found.
+static uint32_t audio_out_set_timer_rate(uint timer, uint32_t sample_rate)
+{
+    uint64_t clock = clock_get_hz(clk_sys);
+    uint32_t best_x = 1;
+    uint32_t best_y = UINT16_MAX;
+    uint64_t best_error = UINT64_MAX;
+
+    // The slowest rate, for sample rates below even that.
+    audio_out_try_fraction(clock, sample_rate, 1, UINT16_MAX, &best_x, &best_y, &best_error);
+
+    uint64_t numerator = sample_rate;
+    uint64_t denominator = clock;
+    uint64_t x0 = 0;
+    uint64_t x1 = 1;
+    uint64_t y0 = 1;
+    uint64_t y1 = 0;
+
+    while (denominator != 0)
+    {
+        uint64_t term = numerator / denominator;
+        uint64_t x2 = term * x1 + x0;
+        uint64_t y2 = term * y1 + y0;
+
+        if (y2 > UINT16_MAX)
+        {
+            // The largest step towards the next convergent that still fits.
+            uint64_t steps = (UINT16_MAX - y0) / y1;
+            audio_out_try_fraction(clock, sample_rate, steps * x1 + x0, steps * y1 + y0, &best_x, &best_y, &best_error);
+            break;
+        }
+
+        audio_out_try_fraction(clock, sample_rate, x2, y2, &best_x, &best_y, &best_error);
+
+        uint64_t remainder = numerator % denominator;
+        numerator = denominator;
+        denominator = remainder;
+        x0 = x1;
+        x1 = x2;
+        y0 = y1;
+        y1 = y2;
+    }
+
+    dma_timer_set_fraction(timer, best_x, best_y);
+    return clock * best_x / best_y;
+}
+
+int audio_out_start(uint8_t pin, uint32_t sample_rate)
+{
+    if (pin >= NUM_BANK0_GPIOS || sample_rate == 0 || sample_rate > clock_get_hz(clk_sys) / (AUDIO_OUT_PWM_WRAP + 1))
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    audio_out_stop();
+
+    block_pool_t * pool = sample_pool_get();
+    uint16_t * block = pool != NULL ? block_pool_alloc(pool) : NULL;
+    int timer = dma_claim_unused_timer(false);
+    int channels[2] = {dma_claim_unused_channel(false), dma_claim_unused_channel(false)};
+
+    if (block == NULL || timer < 0 || channels[0] < 0 || channels[1] < 0)
+    {
+        if (block != NULL)
+        {
+            block_pool_release(pool, block);
+        }
+
+        if (timer >= 0)
+        {
+            dma_timer_unclaim(timer);
+        }
+
+        for (int i = 0; i < 2; i++)
+        {
+            if (channels[i] >= 0)
+            {
+                dma_channel_unclaim(channels[i]);
+            }
+        }
+
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+
+    audio_out_timer = timer;
+    audio_out_buffers[0] = block;
+    audio_out_buffers[1] = block + AUDIO_OUT_BLOCK_SIZE;
+    audio_out_stats = (audio_out_stats_t) {0};
+    audio_out_stats.sample_rate = audio_out_set_timer_rate(timer, sample_rate);
+    audio_out_source = (audio_out_source_t) {0};
+
+    // The PWM runs flat out, far above the audio band, and the DMA timer paces the levels
+    // instead of the wrap, so the carrier stays easy to filter at any sample rate.
+    audio_out_slice = pwm_gpio_to_slice_num(pin);
+    pwm_config pwm_cfg = pwm_get_default_config();
+    pwm_config_set_wrap(&pwm_cfg, AUDIO_OUT_PWM_WRAP);
+    pwm_init(audio_out_slice, &pwm_cfg, false);
+    pwm_set_gpio_level(pin, (AUDIO_OUT_PWM_WRAP + 1) / 2);
+    gpio_set_function(pin, GPIO_FUNC_PWM);
+
+    for (int i = 0; i < 2; i++)
+    {
+        audio_out_render_block(audio_out_buffers[i], AUDIO_OUT_BLOCK_SIZE);
+    }
+
+    // The channels play the buffers alternately. A 16-bit write to the compare register
+    // sets both halves of the slice.
+    dma_ping_pong_configure(channels, DMA_SIZE_16, dma_get_timer_dreq(timer), &pwm_hw->slice[audio_out_slice].cc, (void * [2]) {audio_out_buffers[0], audio_out_buffers[1]}, AUDIO_OUT_BLOCK_SIZE, true, 1);
+    audio_out_dma_channels[0] = channels[0];
+    audio_out_dma_channels[1] = channels[1];
+
+    irq_add_shared_handler(DMA_IRQ_1, audio_out_dma_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    pwm_set_enabled(audio_out_slice, true);
+    dma_channel_start(channels[0]);
+    return PICO_OK;
+}
+
+static void audio_out_set_source(const void * samples, size_t count, uint32_t source_rate, bool is_adc, bool is_looping)
+{
+    if (audio_out_timer < 0 || source_rate == 0)
+    {
+        return;
+    }
+
+    // No samples at all just goes quiet.
+    if (samples == NULL || count == 0)
+    {
+        audio_out_source.is_playing = false;
+        return;
+    }
+
+    audio_out_source_t source =
+    {
+        .samples = samples,
+        .count = count,
+        .step = ((uint64_t) source_rate << 16) / audio_out_stats.sample_rate,
+        .is_adc = is_adc,
+        .is_looping = is_looping,
+        .is_playing = true
+    };
+
+    // The handler may be rendering from the old source, so swap it whole.
+    uint32_t save = save_and_disable_interrupts();
+    audio_out_source = source;
+    restore_interrupts(save);
+}
+
+void audio_out_play(const int16_t * samples, size_t count, uint32_t source_rate, bool is_looping)
+{
+    audio_out_set_source(samples, count, source_rate, false, is_looping);
+}
+
+void audio_out_play_adc(const uint16_t * samples, size_t count, uint32_t source_rate, bool is_looping)
+{
+    audio_out_set_source(samples, count, source_rate, true, is_looping);
+}
+
+void audio_out_set_volume(uint16_t volume)
+{
+    audio_out_volume = volume < AUDIO_OUT_VOLUME_MAX ? volume : AUDIO_OUT_VOLUME_MAX;
+}
+
+bool audio_out_is_playing()
+{
+    return audio_out_source.is_playing;
+}
+
+void audio_out_stop()
+{
+    if (audio_out_timer < 0)
+    {
+        return;
+    }
+
+    dma_ping_pong_stop(audio_out_dma_channels, 1);
+
+    irq_remove_handler(DMA_IRQ_1, audio_out_dma_handler);
+    dma_timer_unclaim(audio_out_timer);
+    audio_out_timer = -1;
+    audio_out_source.is_playing = false;
+    pwm_set_enabled(audio_out_slice, false);
+    block_pool_release(sample_pool_get(), audio_out_buffers[0]);
+}
+
+void audio_out_get_stats(audio_out_stats_t * stats)
+{
+    uint32_t save = save_and_disable_interrupts();
+    *stats = audio_out_stats;
+    restore_interrupts(save);
+}
+
+void audio_out_fill_sine(int16_t * samples, size_t count, uint32_t cycles, int16_t amplitude)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        samples[i] = lroundf(amplitude * sinf(2 * M_PI * cycles * i / count));
+    }
+}
+
+#pragma endregion
@@ -0,0 +1,31 @@
+#include "PicoLibrary.h"
+
+// With PICO_LIBRARY_INLINE these are defined in PicoLibrary.h instead.
+#ifndef PICO_LIBRARY_INLINE
+
+#pragma region Basic Functions
+
+void sleep(uint32_t milliseconds)
+{
+    sleep_ms(milliseconds);
+}
+
+void PICO_LIBRARY_HOT(led_set)(bool led_on)
+{
+    if (!is_led_init)
+    {
+        led_init();
+    }
+
+    #if defined(PICO_DEFAULT_LED_PIN)
+        // Just set the GPIO on or off
+        gpio_put(PICO_DEFAULT_LED_PIN, led_on);
+    #elif defined(CYW43_WL_GPIO_LED_PIN)
+        // Queued for the wifi "driver", and skipped if the LED is already that way
+        pico_w_gpio_put(CYW43_WL_GPIO_LED_PIN, led_on);
+    #endif
+}
+
+#pragma endregion
+
+#endif
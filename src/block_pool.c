@@ -0,0 +1,211 @@
+#include "PicoLibrary.h"
+
+#pragma region Block Pool Functions
+
+// Blocks, then a reference count for each.
+BLOCK_ARENA_MEMORY(sample_pool_memory, SAMPLE_POOL_BLOCKS * (SAMPLE_POOL_BLOCK_SIZE + 1));
+block_arena_t sample_pool_arena;
+block_pool_t sample_pool;
+bool is_sample_pool_init = false;
+
+void block_arena_init(block_arena_t * arena, void * memory, size_t size)
+{
+    arena->memory = memory;
+    arena->size = size;
+    arena->used = 0;
+    arena->high_water = 0;
+    arena->failures = 0;
+}
+
+void * block_arena_alloc(block_arena_t * arena, size_t size, size_t align)
+{
+    if (align < BLOCK_POOL_MIN_ALIGN)
+    {
+        align = BLOCK_POOL_MIN_ALIGN;
+    }
+
+    if (align & (align - 1))
+    {
+        return NULL;
+    }
+
+    uintptr_t base = (uintptr_t) arena->memory;
+    uintptr_t start = (base + arena->used + align - 1) & ~(uintptr_t) (align - 1);
+    size_t end = start - base + size;
+
+    if (end > arena->size)
+    {
+        arena->failures++;
+        return NULL;
+    }
+
+    arena->used = end;
+
+    if (end > arena->high_water)
+    {
+        arena->high_water = end;
+    }
+
+    return (void *) start;
+}
+
+void block_arena_reset(block_arena_t * arena)
+{
+    arena->used = 0;
+}
+
+int block_pool_init(block_pool_t * pool, block_arena_t * arena, size_t block_size, uint16_t block_count, size_t align)
+{
+    if (align < BLOCK_POOL_MIN_ALIGN)
+    {
+        align = BLOCK_POOL_MIN_ALIGN;
+    }
+
+    // Free blocks hold the free list link, so they need room for a pointer.
+    if (block_size < sizeof(void *) || block_count == 0 || (align & (align - 1)))
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    size_t stride = (block_size + align - 1) & ~(align - 1);
+    size_t used = arena->used;
+    uint8_t * blocks = block_arena_alloc(arena, stride * block_count, align);
+    uint8_t * refs = block_arena_alloc(arena, block_count, 1);
+    int lock_num = spin_lock_claim_unused(false);
+
+    if (blocks == NULL || refs == NULL || lock_num < 0)
+    {
+        arena->used = used;
+
+        if (lock_num >= 0)
+        {
+            spin_lock_unclaim(lock_num);
+        }
+
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+
+    pool->blocks = blocks;
+    pool->refs = refs;
+    pool->stride = stride;
+    pool->block_size = block_size;
+    pool->block_count = block_count;
+    pool->in_use = 0;
+    pool->high_water = 0;
+    pool->failures = 0;
+    pool->lock = spin_lock_init(lock_num);
+    pool->free_list = NULL;
+
+    // Linked in reverse so the first allocations come from the start of the pool.
+    for (int i = block_count - 1; i >= 0; i--)
+    {
+        void * block = blocks + i * stride;
+        *(void **) block = pool->free_list;
+        pool->free_list = block;
+        refs[i] = 0;
+    }
+
+    return PICO_OK;
+}
+
+static inline uint32_t block_pool_index(const block_pool_t * pool, const void * block)
+{
+    return ((const uint8_t *) block - pool->blocks) / pool->stride;
+}
+
+void * PICO_LIBRARY_HOT(block_pool_alloc)(block_pool_t * pool)
+{
+    uint32_t save = spin_lock_blocking(pool->lock);
+    void * block = pool->free_list;
+
+    if (block != NULL)
+    {
+        pool->free_list = *(void **) block;
+        pool->refs[block_pool_index(pool, block)] = 1;
+
+        if (++pool->in_use > pool->high_water)
+        {
+            pool->high_water = pool->in_use;
+        }
+    }
+
+    else
+    {
+        pool->failures++;
+    }
+
+    spin_unlock(pool->lock, save);
+    return block;
+}
+
+void PICO_LIBRARY_HOT(block_pool_retain)(block_pool_t * pool, void * block)
+{
+    uint32_t index = block_pool_index(pool, block);
+    uint32_t save = spin_lock_blocking(pool->lock);
+
+    // A count that reaches the limit stays there, the block is never freed rather than
+    // freed while still in use.
+    if (pool->refs[index] != 0 && pool->refs[index] < BLOCK_POOL_MAX_REFS)
+    {
+        pool->refs[index]++;
+    }
+
+    spin_unlock(pool->lock, save);
+}
+
+void PICO_LIBRARY_HOT(block_pool_release)(block_pool_t * pool, void * block)
+{
+    uint32_t index = block_pool_index(pool, block);
+    uint32_t save = spin_lock_blocking(pool->lock);
+    uint8_t refs = pool->refs[index];
+
+    if (refs != 0 && refs < BLOCK_POOL_MAX_REFS)
+    {
+        pool->refs[index] = --refs;
+
+        if (refs == 0)
+        {
+            *(void **) block = pool->free_list;
+            pool->free_list = block;
+            pool->in_use--;
+        }
+    }
+
+    spin_unlock(pool->lock, save);
+}
+
+uint8_t block_pool_refs(block_pool_t * pool, void * block)
+{
+    return pool->refs[block_pool_index(pool, block)];
+}
+
+void block_pool_get_stats(block_pool_t * pool, block_pool_stats_t * stats)
+{
+    uint32_t save = spin_lock_blocking(pool->lock);
+    stats->block_size = pool->block_size;
+    stats->block_count = pool->block_count;
+    stats->in_use = pool->in_use;
+    stats->high_water = pool->high_water;
+    stats->failures = pool->failures;
+    spin_unlock(pool->lock, save);
+}
+
+block_pool_t * sample_pool_get()
+{
+    // Set up on first use, as the ADC and FFT are. The callers all start from thread context.
+    if (!is_sample_pool_init)
+    {
+        block_arena_init(&sample_pool_arena, sample_pool_memory, sizeof(sample_pool_memory));
+
+        if (block_pool_init(&sample_pool, &sample_pool_arena, SAMPLE_POOL_BLOCK_SIZE, SAMPLE_POOL_BLOCKS, BLOCK_POOL_MIN_ALIGN) != PICO_OK)
+        {
+            return NULL;
+        }
+
+        is_sample_pool_init = true;
+    }
+
+    return &sample_pool;
+}
+
+#pragma endregion
@@ -0,0 +1,47 @@
+#include "PicoLibrary.h"
+
+#pragma region Boot Functions
+
+boot_phase_t boot_phases[BOOT_MAX_PHASES];
+uint8_t boot_phase_count = 0;
+
+// Constructors run at the end of the runtime's start-up, right before main.
+static void __attribute__((constructor)) boot_mark_runtime_init()
+{
+    boot_mark("runtime init");
+}
+
+void boot_mark(const char * name)
+{
+    uint32_t save = save_and_disable_interrupts();
+
+    if (boot_phase_count < BOOT_MAX_PHASES)
+    {
+        boot_phases[boot_phase_count].name = name;
+        boot_phases[boot_phase_count].time_us = time_us_32();
+        boot_phase_count++;
+    }
+
+    restore_interrupts(save);
+}
+
+size_t boot_get_phases(const boot_phase_t ** phases)
+{
+    *phases = boot_phases;
+    return boot_phase_count;
+}
+
+void boot_report()
+{
+    uint32_t previous = 0;
+
+    printf("Boot phases:\n");
+
+    for (uint8_t i = 0; i < boot_phase_count; i++)
+    {
+        printf("%10lu us (+%lu us) %s\n", boot_phases[i].time_us, boot_phases[i].time_us - previous, boot_phases[i].name);
+        previous = boot_phases[i].time_us;
+    }
+}
+
+#pragma endregion
@@ -0,0 +1,95 @@
+#include "PicoLibrary.h"
+
+#pragma region Conversion Functions
+
+void convert_table_millivolts(int16_t * table)
+{
+    for (uint32_t i = 0; i < CONVERT_TABLE_SIZE; i++)
+    {
+        table[i] = (i * 3300 + CONVERT_TABLE_SIZE / 2) / CONVERT_TABLE_SIZE;
+    }
+}
+
+void convert_table_temperature(int16_t * table)
+{
+    const float conversion_factor = ADC_VOLTS_PER_CODE;
+
+    for (uint32_t i = 0; i < CONVERT_TABLE_SIZE; i++)
+    {
+        float temp_c = 27.0f - (i * conversion_factor - 0.706f) / 0.001721f;
+        table[i] = (int16_t) lroundf(temp_c * 100);
+    }
+}
+
+uint32_t convert_scale_factor(uint32_t numerator, uint32_t denominator)
+{
+    // Done once per batch so the per-sample work is a multiply, not a divide. 64-bit so
+    // numerators of 65536 and up keep their top bits.
+    if (denominator == 0)
+    {
+        return UINT32_MAX;
+    }
+
+    uint64_t scale = ((uint64_t) numerator << 16) / denominator;
+
+    return scale > UINT32_MAX ? UINT32_MAX : scale;
+}
+
+void PICO_LIBRARY_HOT(convert_lookup_batch)(const uint16_t * raw, int16_t * output, size_t count, const int16_t * table)
+{
+    if (count && ((uintptr_t) raw & 2))
+    {
+        *output++ = table[*raw++ & (CONVERT_TABLE_SIZE - 1)];
+        count--;
+    }
+
+    // Samples are read two at a time as one word, shifted left once so both
+    // lanes produce a byte offset: lane 0 from the low half, lane 1 from the high half.
+    interp_config cfg = interp_default_config();
+    interp_config_set_shift(&cfg, 0);
+    interp_config_set_mask(&cfg, 1, 12);
+    interp_set_config(interp0, 0, &cfg);
+
+    interp_config_set_shift(&cfg, 16);
+    interp_config_set_cross_input(&cfg, true);
+    interp_set_config(interp0, 1, &cfg);
+
+    interp0->base[0] = (uintptr_t) table;
+    interp0->base[1] = (uintptr_t) table;
+
+    const uint32_t * words = (const uint32_t *) raw;
+    size_t pairs = count / 2;
+
+    for (size_t i = 0; i < pairs; i++)
+    {
+        interp0->accum[0] = words[i] << 1;
+        output[i * 2] = *(const int16_t *) interp0->peek[0];
+        output[i * 2 + 1] = *(const int16_t *) interp0->peek[1];
+    }
+
+    if (count & 1)
+    {
+        output[count - 1] = table[raw[count - 1] & (CONVERT_TABLE_SIZE - 1)];
+    }
+}
+
+void PICO_LIBRARY_HOT(convert_scale_clamp_batch)(const uint16_t * raw, uint16_t * output, size_t count, uint32_t scale, uint16_t minimum, uint16_t maximum)
+{
+    // Only interp1 lane 0 can clamp, between base 0 and base 1.
+    interp_config cfg = interp_default_config();
+    interp_config_set_clamp(&cfg, true);
+    interp_config_set_shift(&cfg, 16);
+    interp_config_set_mask(&cfg, 0, 15);
+    interp_set_config(interp1, 0, &cfg);
+
+    interp1->base[0] = minimum;
+    interp1->base[1] = maximum;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        interp1->accum[0] = raw[i] * scale;
+        output[i] = interp1->peek[0];
+    }
+}
+
+#pragma endregion
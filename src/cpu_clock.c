@@ -0,0 +1,138 @@
+#include "PicoLibrary.h"
+#include "hardware/claim.h"
+
+// Weak so the library links whether or not the image has UART stdio.
+void stdio_uart_init() __attribute__((weak));
+
+#pragma region CPU Clock
+
+volatile bool is_fc0_claimed = false;
+
+// The hardware claim lock, as the SDK's own claims use, so both cores can claim.
+bool cpu_clock_fc0_claim()
+{
+    uint32_t save = hw_claim_lock();
+    bool is_claimed = !is_fc0_claimed;
+    is_fc0_claimed = true;
+    hw_claim_unlock(save);
+    return is_claimed;
+}
+
+void cpu_clock_fc0_unclaim()
+{
+    is_fc0_claimed = false;
+}
+
+// freq_counter restarts FC0 between its intervals, a count started in between would be of
+// the wrong clock and leave freq_counter with this one.
+static uint64_t cpu_clock_count_hz(uint source)
+{
+    if (!cpu_clock_fc0_claim())
+    {
+        return 0;
+    }
+
+    uint64_t hz = frequency_count_khz(source) * 1000ull;
+    cpu_clock_fc0_unclaim();
+    return hz;
+}
+
+uint64_t cpu_clock_get_hz_pll_sys()
+{
+    return cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_PLL_SYS_CLKSRC_PRIMARY);
+}
+
+uint64_t cpu_clock_get_hz_pll_usb()
+{
+    return cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_PLL_USB_CLKSRC_PRIMARY);
+}
+
+uint64_t cpu_clock_get_hz_rosc()
+{
+    return cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_ROSC_CLKSRC);
+}
+
+uint64_t cpu_clock_get_hz_system()
+{
+    return cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_CLK_SYS);
+}
+
+uint64_t cpu_clock_get_hz_peri()
+{
+    return cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_CLK_PERI);
+}
+
+uint64_t cpu_clock_get_hz_usb()
+{
+    return cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_CLK_USB);
+}
+
+uint64_t cpu_clock_get_hz_adc()
+{
+    return cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_CLK_ADC);
+}
+
+uint64_t cpu_clock_get_hz_rtc()
+{
+    #ifdef CLOCKS_FC0_SRC_VALUE_CLK_RTC
+        return cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_CLK_RTC);
+    #else
+        return 0;
+    #endif
+}
+
+uint64_t * cpu_clock_get_all()
+{
+    uint64_t tempOutput[8] = 
+    {
+        cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_PLL_SYS_CLKSRC_PRIMARY),
+        cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_PLL_USB_CLKSRC_PRIMARY),
+        cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_ROSC_CLKSRC),
+        cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_CLK_SYS),
+        cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_CLK_PERI),
+        cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_CLK_USB),
+        cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_CLK_ADC),
+        #ifdef CLOCKS_FC0_SRC_VALUE_CLK_RTC
+            cpu_clock_count_hz(CLOCKS_FC0_SRC_VALUE_CLK_RTC)
+        #endif
+    };
+
+    uint64_t * output = tempOutput;
+
+    return output;
+}
+
+void cpu_clock_set(int hertz)
+{
+    // Change clk_sys to be 48MHz. The simplest way is to take this from PLL_USB
+    // which has a source frequency of 48MHz
+    clock_configure(clk_sys,
+                    CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                    CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB,
+                    hertz,
+                    hertz);
+
+    // Turn off PLL sys for good measure
+    pll_deinit(pll_sys);
+
+    // CLK peri is clocked from clk_sys so need to change clk_peri's freq
+    clock_configure(clk_peri,
+                    0,
+                    CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLK_SYS,
+                    hertz,
+                    hertz);
+
+    // Re init uart now that clk_peri has changed. Only the UART depends on clk_peri,
+    // stdio_init_all would also restart USB.
+    if (stdio_uart_init != NULL)
+    {
+        stdio_uart_init();
+    }
+}
+
+void gpio_pin_underclock(uint8_t pin, float underclock_by, uint source)
+{
+    clock_gpio_init(pin, source, underclock_by);
+}
+
+#pragma endregion
@@ -0,0 +1,113 @@
+#include "PicoLibrary.h"
+
+#pragma region Debounce Functions
+
+uint32_t debounce_pin_mask = 0;
+uint32_t debounce_invert_mask = 0;
+uint32_t debounce_state = 0;
+uint32_t debounce_count_low = 0;
+uint32_t debounce_count_high = 0;
+uint32_t debounce_hold_count[DEBOUNCE_HOLD_BITS];
+uint32_t debounce_held = 0;
+uint16_t debounce_hold_ticks = 0;
+debounce_events_t debounce_events;
+repeating_timer_t debounce_timer;
+
+void PICO_LIBRARY_HOT(debounce_tick)(uint32_t sample)
+{
+    uint32_t pressed_before = debounce_state;
+
+    // Two-bit vertical counters, one bit plane per word, so all pins are debounced at once.
+    // A pin only toggles once it has differed from the debounced state for four ticks.
+    uint32_t delta = ((sample ^ debounce_invert_mask) & debounce_pin_mask) ^ debounce_state;
+    debounce_count_high = (debounce_count_high ^ debounce_count_low) & delta;
+    debounce_count_low = ~debounce_count_low & delta;
+    uint32_t toggle = delta & ~(debounce_count_low | debounce_count_high);
+    debounce_state ^= toggle;
+
+    uint32_t pressed = debounce_state;
+
+    // Hold time counters, cleared on release and stopped once the hold has been reported.
+    // With hold_ticks 0 they would match on wrapping back to 0, so nothing is reported.
+    uint32_t carry = pressed & ~debounce_held;
+    uint32_t is_hold_time = debounce_hold_ticks ? carry : 0;
+
+    for (int bit = 0; bit < DEBOUNCE_HOLD_BITS; bit++)
+    {
+        uint32_t count = debounce_hold_count[bit] & pressed;
+        debounce_hold_count[bit] = count ^ carry;
+        carry &= count;
+        is_hold_time &= (debounce_hold_ticks >> bit) & 1 ? debounce_hold_count[bit] : ~debounce_hold_count[bit];
+    }
+
+    debounce_held = (debounce_held | is_hold_time) & pressed;
+
+    debounce_events.pressed |= toggle & pressed;
+    debounce_events.released |= toggle & pressed_before;
+    debounce_events.held |= is_hold_time;
+}
+
+static bool PICO_LIBRARY_HOT(debounce_timer_callback)(repeating_timer_t * timer)
+{
+    debounce_tick(gpio_get_all());
+    return true;
+}
+
+void debounce_reset(uint32_t pin_mask, uint32_t active_low_mask, uint16_t hold_ticks)
+{
+    debounce_pin_mask = pin_mask & ((1u << NUM_BANK0_GPIOS) - 1);
+    debounce_invert_mask = active_low_mask;
+    debounce_hold_ticks = hold_ticks < (1 << DEBOUNCE_HOLD_BITS) ? hold_ticks : (1 << DEBOUNCE_HOLD_BITS) - 1;
+    debounce_state = 0;
+    debounce_count_low = 0;
+    debounce_count_high = 0;
+    debounce_held = 0;
+    debounce_events = (debounce_events_t) {0};
+
+    for (int bit = 0; bit < DEBOUNCE_HOLD_BITS; bit++)
+    {
+        debounce_hold_count[bit] = 0;
+    }
+}
+
+int debounce_start(uint32_t pin_mask, uint32_t active_low_mask, uint32_t tick_us, uint16_t hold_ticks)
+{
+    debounce_reset(pin_mask, active_low_mask, hold_ticks);
+    gpio_init_mask(debounce_pin_mask);
+
+    for (uint8_t pin = 0; pin < NUM_BANK0_GPIOS; pin++)
+    {
+        if (debounce_pin_mask & (1u << pin))
+        {
+            gpio_set_pulls(pin, (active_low_mask >> pin) & 1, !((active_low_mask >> pin) & 1));
+        }
+    }
+
+    // A negative delay keeps the period fixed regardless of how long the callback takes.
+    if (!add_repeating_timer_us(-(int64_t) tick_us, debounce_timer_callback, NULL, &debounce_timer))
+    {
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+
+    return PICO_OK;
+}
+
+void debounce_stop()
+{
+    cancel_repeating_timer(&debounce_timer);
+}
+
+uint32_t debounce_get_state()
+{
+    return debounce_state;
+}
+
+void debounce_get_events(debounce_events_t * events)
+{
+    uint32_t save = save_and_disable_interrupts();
+    *events = debounce_events;
+    debounce_events = (debounce_events_t) {0};
+    restore_interrupts(save);
+}
+
+#pragma endregion
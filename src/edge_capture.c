@@ -0,0 +1,260 @@
+#include "PicoLibrary.h"
+
+#pragma region Edge Capture Functions
+
+edge_event_t edge_buffer[EDGE_BUFFER_SIZE];
+volatile uint32_t edge_head = 0;
+volatile uint32_t edge_tail = 0;
+volatile uint32_t edge_overruns = 0;
+volatile uint32_t edge_missed = 0;
+uint32_t edge_pin_mask = 0;
+edge_stats_t edge_stats[NUM_BANK0_GPIOS];
+
+static inline void edge_push(uint64_t timestamp, uint8_t pin, bool is_rising, bool is_missed)
+{
+    uint32_t head = edge_head;
+
+    // Single producer, single consumer: only this handler moves the head.
+    if (head - edge_tail >= EDGE_BUFFER_SIZE)
+    {
+        edge_overruns++;
+        return;
+    }
+
+    edge_event_t * event = &edge_buffer[head & (EDGE_BUFFER_SIZE - 1)];
+    event->timestamp = timestamp;
+    event->pin = pin;
+    event->is_rising = is_rising;
+    event->is_missed = is_missed;
+
+    __dmb();
+    edge_head = head + 1;
+}
+
+static void PICO_LIBRARY_HOT(edge_irq_handler)()
+{
+    uint64_t timestamp = time_us_64();
+    io_bank0_irq_ctrl_hw_t * irq_ctrl = get_core_num() ? &io_bank0_hw->proc1_irq_ctrl : &io_bank0_hw->proc0_irq_ctrl;
+
+    // Each status register holds four event bits for eight pins, edges are bits 2 (fall) and 3 (rise).
+    for (uint reg = 0; reg < 4; reg++)
+    {
+        uint32_t pins = (edge_pin_mask >> (reg * 8)) & 0xff;
+
+        if (!pins)
+        {
+            continue;
+        }
+
+        // Only the edge bits of these pins, other GPIO interrupt users keep theirs.
+        uint32_t edge_bits = 0;
+
+        for (uint i = 0; i < 8; i++)
+        {
+            if (pins & (1 << i))
+            {
+                edge_bits |= (GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL) << (i * 4);
+            }
+        }
+
+        uint32_t status = irq_ctrl->ints[reg] & edge_bits;
+
+        if (!status)
+        {
+            continue;
+        }
+
+        io_bank0_hw->intr[reg] = status;
+
+        for (uint i = 0; i < 8; i++)
+        {
+            uint32_t events = (status >> (i * 4)) & (GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL);
+
+            if (!events)
+            {
+                continue;
+            }
+
+            uint8_t pin = reg * 8 + i;
+
+            if (events == (GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL))
+            {
+                // Both edges latched since the last interrupt, so at least one pair was
+                // missed. The pin's level says which came last, but not when.
+                bool is_high = gpio_get(pin);
+                edge_missed++;
+                edge_push(timestamp, pin, !is_high, true);
+                edge_push(timestamp, pin, is_high, true);
+            }
+
+            else
+            {
+                edge_push(timestamp, pin, events == GPIO_IRQ_EDGE_RISE, false);
+            }
+        }
+    }
+}
+
+int edge_capture_start(uint32_t pin_mask)
+{
+    if (!pin_mask || (pin_mask >> NUM_BANK0_GPIOS))
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    if (edge_pin_mask)
+    {
+        return PICO_ERROR_NOT_PERMITTED;
+    }
+
+    edge_pin_mask = pin_mask;
+    edge_head = 0;
+    edge_tail = 0;
+    edge_overruns = 0;
+    edge_missed = 0;
+
+    for (uint8_t pin = 0; pin < NUM_BANK0_GPIOS; pin++)
+    {
+        edge_stats[pin] = (edge_stats_t) {0};
+    }
+
+    gpio_add_raw_irq_handler_masked(pin_mask, edge_irq_handler);
+
+    for (uint8_t pin = 0; pin < NUM_BANK0_GPIOS; pin++)
+    {
+        if (pin_mask & (1u << pin))
+        {
+            gpio_set_input_enabled(pin, true);
+            gpio_acknowledge_irq(pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL);
+            gpio_set_irq_enabled(pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+        }
+    }
+
+    irq_set_enabled(IO_IRQ_BANK0, true);
+    return PICO_OK;
+}
+
+void edge_capture_stop()
+{
+    for (uint8_t pin = 0; pin < NUM_BANK0_GPIOS; pin++)
+    {
+        if (edge_pin_mask & (1u << pin))
+        {
+            gpio_set_irq_enabled(pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, false);
+        }
+    }
+
+    gpio_remove_raw_irq_handler_masked(edge_pin_mask, edge_irq_handler);
+    edge_pin_mask = 0;
+}
+
+bool PICO_LIBRARY_HOT(edge_capture_pop)(edge_event_t * event)
+{
+    uint32_t tail = edge_tail;
+
+    if (tail == edge_head)
+    {
+        return false;
+    }
+
+    __dmb();
+    *event = edge_buffer[tail & (EDGE_BUFFER_SIZE - 1)];
+    edge_tail = tail + 1;
+
+    return true;
+}
+
+size_t PICO_LIBRARY_HOT(edge_capture_process)()
+{
+    edge_event_t event;
+    size_t count = 0;
+
+    while (edge_capture_pop(&event))
+    {
+        edge_stats_t * stats = &edge_stats[event.pin];
+        stats->edge_count++;
+        count++;
+
+        // Missed edges make the times around them meaningless, periods start again from
+        // the next edge that was seen.
+        if (event.is_missed)
+        {
+            stats->last_rise = 0;
+            stats->last_fall = 0;
+            continue;
+        }
+
+        if (event.is_rising)
+        {
+            if (stats->last_rise)
+            {
+                uint32_t period = event.timestamp - stats->last_rise;
+
+                stats->period_us = period;
+                stats->period_sum_us += period;
+                stats->period_count++;
+            }
+
+            if (stats->last_fall)
+            {
+                stats->low_us = event.timestamp - stats->last_fall;
+            }
+
+            stats->last_rise = event.timestamp;
+        }
+
+        else
+        {
+            if (stats->last_rise)
+            {
+                stats->high_us = event.timestamp - stats->last_rise;
+            }
+
+            stats->last_fall = event.timestamp;
+        }
+    }
+
+    return count;
+}
+
+void edge_capture_get_stats(uint8_t pin, edge_stats_t * stats)
+{
+    *stats = edge_stats[pin];
+}
+
+float edge_capture_frequency(uint8_t pin)
+{
+    const edge_stats_t * stats = &edge_stats[pin];
+
+    // Averaged over every full period seen, so jitter of the 1 us timestamps cancels out.
+    if (!stats->period_count)
+    {
+        return 0;
+    }
+
+    return 1000000.0f * stats->period_count / stats->period_sum_us;
+}
+
+float edge_capture_duty_cycle(uint8_t pin)
+{
+    const edge_stats_t * stats = &edge_stats[pin];
+
+    if (!stats->high_us && !stats->low_us)
+    {
+        return 0;
+    }
+
+    return (float) stats->high_us / (stats->high_us + stats->low_us);
+}
+
+uint32_t edge_capture_overruns()
+{
+    return edge_overruns;
+}
+
+uint32_t edge_capture_missed()
+{
+    return edge_missed;
+}
+
+#pragma endregion
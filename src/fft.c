@@ -0,0 +1,232 @@
+#include <math.h>
+#include <stdlib.h>
+#include "fft.h"
+
+#pragma region FFT Functions
+
+int16_t fft_sine_table[FFT_MAX_POINTS / 4 + 1];
+bool is_fft_init = false;
+
+void fft_init()
+{
+    if (!is_fft_init)
+    {
+        // Quarter wave, the other three quadrants are mirrored from it in fft_sine.
+        for (int i = 0; i <= FFT_MAX_POINTS / 4; i++)
+        {
+            int32_t value = lround(sin(2 * M_PI * i / FFT_MAX_POINTS) * 32768);
+            fft_sine_table[i] = value > INT16_MAX ? INT16_MAX : value;
+        }
+
+        is_fft_init = true;
+    }
+}
+
+// Sine of index * 2 pi / FFT_MAX_POINTS in Q15.
+static inline int16_t fft_sine(uint32_t index)
+{
+    const uint32_t quarter = FFT_MAX_POINTS / 4;
+
+    index &= FFT_MAX_POINTS - 1;
+
+    if (index < quarter)
+    {
+        return fft_sine_table[index];
+    }
+
+    else if (index < quarter * 2)
+    {
+        return fft_sine_table[quarter * 2 - index];
+    }
+
+    else if (index < quarter * 3)
+    {
+        return -fft_sine_table[index - quarter * 2];
+    }
+
+    return -fft_sine_table[quarter * 4 - index];
+}
+
+static inline int16_t fft_cosine(uint32_t index)
+{
+    return fft_sine(index + FFT_MAX_POINTS / 4);
+}
+
+static bool fft_is_valid_size(size_t points)
+{
+    return points >= FFT_MIN_POINTS && points <= FFT_MAX_POINTS && (points & (points - 1)) == 0;
+}
+
+int fft_load_samples(fft_complex_t * data, const uint16_t * samples, size_t points, bool window)
+{
+    if (!fft_is_valid_size(points))
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    fft_init();
+
+    const uint32_t step = FFT_MAX_POINTS / points;
+
+    for (size_t i = 0; i < points; i++)
+    {
+        // 12-bit unsigned ADC codes centred on mid-scale become Q15.
+        int32_t sample = ((int32_t) samples[i] - 2048) << 4;
+
+        if (window)
+        {
+            // Hann window, (1 - cos) / 2, taken from the twiddle table.
+            int32_t hann = (32767 - fft_cosine(i * step)) >> 1;
+            sample = (sample * hann) >> 15;
+        }
+
+        data[i].real = sample;
+        data[i].imag = 0;
+    }
+
+    return PICO_OK;
+}
+
+int PICO_LIBRARY_HOT(fft_transform)(fft_complex_t * data, size_t points)
+{
+    if (!fft_is_valid_size(points))
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    fft_init();
+
+    // Bit-reversed reordering so the butterflies can run in place.
+    for (size_t i = 1, j = 0; i < points; i++)
+    {
+        size_t bit = points >> 1;
+
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+
+        j ^= bit;
+
+        if (i < j)
+        {
+            fft_complex_t swap = data[i];
+            data[i] = data[j];
+            data[j] = swap;
+        }
+    }
+
+    // The first two stages only need the twiddles 1 and -j, so they are done
+    // together as one radix-4 pass without any multiplies.
+    for (size_t k = 0; k < points; k += 4)
+    {
+        fft_complex_t * x = &data[k];
+        int32_t a0_real = x[0].real + x[1].real, a0_imag = x[0].imag + x[1].imag;
+        int32_t a1_real = x[0].real - x[1].real, a1_imag = x[0].imag - x[1].imag;
+        int32_t a2_real = x[2].real + x[3].real, a2_imag = x[2].imag + x[3].imag;
+        int32_t a3_real = x[2].real - x[3].real, a3_imag = x[2].imag - x[3].imag;
+
+        x[0].real = (a0_real + a2_real) >> 2;
+        x[0].imag = (a0_imag + a2_imag) >> 2;
+        x[1].real = (a1_real + a3_imag) >> 2;
+        x[1].imag = (a1_imag - a3_real) >> 2;
+        x[2].real = (a0_real - a2_real) >> 2;
+        x[2].imag = (a0_imag - a2_imag) >> 2;
+        x[3].real = (a1_real - a3_imag) >> 2;
+        x[3].imag = (a1_imag + a3_real) >> 2;
+    }
+
+    // Remaining radix-2 stages, halving every stage so the output is scaled by 1 / points.
+    for (size_t half = 4; half < points; half <<= 1)
+    {
+        const uint32_t step = FFT_MAX_POINTS / (half * 2);
+
+        for (size_t j = 0; j < half; j++)
+        {
+            const int32_t twiddle_real = fft_cosine(j * step);
+            const int32_t twiddle_imag = -fft_sine(j * step);
+
+            for (size_t k = j; k < points; k += half * 2)
+            {
+                fft_complex_t * a = &data[k];
+                fft_complex_t * b = &data[k + half];
+                int32_t t_real = (b->real * twiddle_real - b->imag * twiddle_imag) >> 15;
+                int32_t t_imag = (b->real * twiddle_imag + b->imag * twiddle_real) >> 15;
+                int32_t a_real = a->real;
+                int32_t a_imag = a->imag;
+
+                a->real = (a_real + t_real) >> 1;
+                a->imag = (a_imag + t_imag) >> 1;
+                b->real = (a_real - t_real) >> 1;
+                b->imag = (a_imag - t_imag) >> 1;
+            }
+        }
+    }
+
+    return PICO_OK;
+}
+
+static uint16_t PICO_LIBRARY_HOT(square_root_uint32)(uint32_t value)
+{
+    uint32_t result = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+
+    while (bit)
+    {
+        if (value >= result + bit)
+        {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        }
+
+        else
+        {
+            result >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    return result;
+}
+
+void PICO_LIBRARY_HOT(fft_magnitude)(const fft_complex_t * data, uint16_t * magnitude, size_t points)
+{
+    // Real input, so only the first half of the bins is unique.
+    for (size_t i = 0; i < points / 2; i++)
+    {
+        // Unsigned, two parts of -32768 add up to 2^31.
+        uint32_t real = abs(data[i].real);
+        uint32_t imag = abs(data[i].imag);
+
+        magnitude[i] = square_root_uint32(real * real + imag * imag);
+    }
+}
+
+size_t PICO_LIBRARY_HOT(fft_peak_bin)(const uint16_t * magnitude, size_t bins)
+{
+    size_t peak = 1;
+
+    // Bin 0 is DC, so start looking from bin 1.
+    for (size_t i = 2; i < bins; i++)
+    {
+        if (magnitude[i] > magnitude[peak])
+        {
+            peak = i;
+        }
+    }
+
+    return peak;
+}
+
+float fft_bin_frequency(size_t bin, size_t points, float sample_rate)
+{
+    return bin * sample_rate / points;
+}
+
+#pragma endregion
@@ -0,0 +1,24 @@
+#ifndef PICO_LIBRARY_FFT_H_
+#define PICO_LIBRARY_FFT_H_
+
+#include "portable.h"
+
+// FFT functions
+// Fixed-point FFT on Q15 blocks of 256 to 4096 points. Output is scaled by 1 / points.
+#define FFT_MIN_POINTS 256
+#define FFT_MAX_POINTS 4096
+
+typedef struct
+{
+    int16_t real;
+    int16_t imag;
+} fft_complex_t;
+
+void fft_init();
+int fft_load_samples(fft_complex_t * data, const uint16_t * samples, size_t points, bool window);
+int PICO_LIBRARY_HOT(fft_transform)(fft_complex_t * data, size_t points);
+void PICO_LIBRARY_HOT(fft_magnitude)(const fft_complex_t * data, uint16_t * magnitude, size_t points);
+size_t PICO_LIBRARY_HOT(fft_peak_bin)(const uint16_t * magnitude, size_t bins);
+float fft_bin_frequency(size_t bin, size_t points, float sample_rate);
+
+#endif
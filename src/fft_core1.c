@@ -0,0 +1,74 @@
+#include "PicoLibrary.h"
+
+#pragma region FFT Job Functions
+
+fft_job_t * volatile fft_pending_job = NULL;
+
+void fft_run_job(fft_job_t * job)
+{
+    uint32_t start = cycle_counter_get();
+
+    fft_transform(job->data, job->points);
+    fft_magnitude(job->data, job->magnitude, job->points);
+    job->peak_bin = fft_peak_bin(job->magnitude, job->points / 2);
+    job->cycles = cycle_counter_elapsed(start);
+}
+
+static void fft_core1_entry()
+{
+    cycle_counter_start();
+
+    // Lets flash_log park this core while flash is erased or programmed.
+    flash_safe_execute_core_init();
+
+    while (true)
+    {
+        while (!fft_pending_job)
+        {
+            __wfe();
+        }
+
+        // Taking the job frees the slot, so the next one can be submitted while this runs.
+        fft_job_t * job = fft_pending_job;
+        fft_pending_job = NULL;
+        __sev();
+
+        fft_run_job(job);
+
+        __dmb();
+        job->is_busy = false;
+        __sev();
+    }
+}
+
+void fft_core1_start()
+{
+    fft_init();
+    multicore_launch_core1(fft_core1_entry);
+}
+
+void fft_core1_submit(fft_job_t * job)
+{
+    fft_core1_wait(job);
+
+    // Another job is waiting to be taken, this one goes after it.
+    while (fft_pending_job != NULL)
+    {
+        __wfe();
+    }
+
+    job->is_busy = true;
+    __dmb();
+    fft_pending_job = job;
+    __sev();
+}
+
+void fft_core1_wait(fft_job_t * job)
+{
+    while (job->is_busy)
+    {
+        __wfe();
+    }
+}
+
+#pragma endregion
@@ -0,0 +1,428 @@
+#include "flash_log.h"
+
+#pragma region Flash Log Functions
+
+const flash_log_backend_t * flash_log_backend = NULL;
+uint32_t flash_log_sectors = 0;
+uint32_t flash_log_sector = 0;
+uint32_t flash_log_sequence = 0;
+uint32_t flash_log_position = 0;
+uint32_t flash_log_flushed = 0;
+uint8_t flash_log_page[FLASH_PAGE_SIZE] __aligned(4);
+uint8_t flash_log_program_buffer[FLASH_PAGE_SIZE] __aligned(4);
+uint32_t flash_log_record_crc; // Of the record being written
+flash_log_stats_t flash_log_stats;
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t sequence;
+} flash_log_sector_header_t;
+
+typedef struct
+{
+    uint16_t length;
+    uint16_t check; // ~length, so erased headers and torn lengths are rejected
+} flash_log_record_header_t;
+
+// Header, data, then the CRC of both, which is written last, padded to a word.
+static inline uint32_t flash_log_record_size(uint16_t length)
+{
+    return (sizeof(flash_log_record_header_t) + length + sizeof(uint32_t) + 3) & ~3u;
+}
+
+// CRC-32 as in zlib, continued from crc, four bits at a time from a 16 entry table.
+static uint32_t flash_log_crc32(uint32_t crc, const uint8_t * data, size_t count)
+{
+    static const uint32_t table[16] =
+    {
+        0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+        0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+    };
+
+    crc = ~crc;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ table[crc & 0xf];
+        crc = (crc >> 4) ^ table[crc & 0xf];
+    }
+
+    return ~crc;
+}
+
+static bool flash_log_sector_is_valid(uint32_t sector, uint32_t * sequence)
+{
+    const flash_log_sector_header_t * header = (const flash_log_sector_header_t *) (flash_log_backend->base + sector * FLASH_SECTOR_SIZE);
+
+    if (header->magic != FLASH_LOG_MAGIC)
+    {
+        return false;
+    }
+
+    *sequence = header->sequence;
+    return true;
+}
+
+// Length of the record at offset in sector, 0 at the end of the written data or a torn record.
+// Everything up to the CRC has to match, a header alone is not enough.
+static uint16_t flash_log_record_at(uint32_t sector, uint32_t offset)
+{
+    if (offset + sizeof(flash_log_record_header_t) > FLASH_SECTOR_SIZE)
+    {
+        return 0;
+    }
+
+    const flash_log_record_header_t * header = (const flash_log_record_header_t *) (flash_log_backend->base + sector * FLASH_SECTOR_SIZE + offset);
+
+    if ((uint16_t) ~header->length != header->check || header->length == 0 || header->length > FLASH_LOG_MAX_RECORD)
+    {
+        return 0;
+    }
+
+    if (offset + flash_log_record_size(header->length) > FLASH_SECTOR_SIZE)
+    {
+        return 0;
+    }
+
+    const uint8_t * record = (const uint8_t *) header;
+    uint32_t length = sizeof(flash_log_record_header_t) + header->length;
+    uint32_t crc;
+    memcpy(&crc, record + length, sizeof(crc));
+
+    if (flash_log_crc32(0, record, length) != crc)
+    {
+        return 0;
+    }
+
+    return header->length;
+}
+
+static int flash_log_program_page()
+{
+    uint32_t page_offset = flash_log_position & ~(FLASH_PAGE_SIZE - 1);
+
+    // Bytes already programmed by an earlier flush are left erased so they are not programmed twice.
+    memset(flash_log_program_buffer, 0xff, flash_log_flushed);
+    memcpy(flash_log_program_buffer + flash_log_flushed, flash_log_page + flash_log_flushed, FLASH_PAGE_SIZE - flash_log_flushed);
+
+    int result = flash_log_backend->program_page(flash_log_sector * FLASH_SECTOR_SIZE + page_offset, flash_log_program_buffer);
+    flash_log_stats.pages_programmed++;
+
+    return result;
+}
+
+static int flash_log_write_bytes(const uint8_t * data, uint32_t count)
+{
+    while (count)
+    {
+        uint32_t in_page = flash_log_position & (FLASH_PAGE_SIZE - 1);
+        uint32_t chunk = FLASH_PAGE_SIZE - in_page;
+
+        if (chunk > count)
+        {
+            chunk = count;
+        }
+
+        if (data)
+        {
+            memcpy(flash_log_page + in_page, data, chunk);
+            data += chunk;
+        }
+
+        else
+        {
+            memset(flash_log_page + in_page, 0, chunk);
+        }
+
+        count -= chunk;
+
+        // Whole pages go to flash as soon as they fill, anything less waits in RAM.
+        if (in_page + chunk == FLASH_PAGE_SIZE)
+        {
+            int result = flash_log_program_page();
+            flash_log_position += chunk;
+            flash_log_flushed = 0;
+            memset(flash_log_page, 0xff, FLASH_PAGE_SIZE);
+
+            if (result != PICO_OK)
+            {
+                return result;
+            }
+        }
+
+        else
+        {
+            flash_log_position += chunk;
+        }
+    }
+
+    return PICO_OK;
+}
+
+static int flash_log_open_next_sector()
+{
+    int result = flash_log_flush();
+
+    if (result != PICO_OK)
+    {
+        return result;
+    }
+
+    // Sectors are used round robin, so every sector is erased equally often and the
+    // oldest sector is the one given up when the log wraps.
+    flash_log_sector = (flash_log_sector + 1) % flash_log_sectors;
+    flash_log_sequence++;
+    flash_log_position = 0;
+    flash_log_flushed = 0;
+    memset(flash_log_page, 0xff, FLASH_PAGE_SIZE);
+
+    result = flash_log_backend->erase_sector(flash_log_sector * FLASH_SECTOR_SIZE);
+    flash_log_stats.sectors_erased++;
+
+    if (result != PICO_OK)
+    {
+        return result;
+    }
+
+    flash_log_sector_header_t header = {FLASH_LOG_MAGIC, flash_log_sequence};
+    return flash_log_write_bytes((const uint8_t *) &header, sizeof(header));
+}
+
+int flash_log_init_with_backend(const flash_log_backend_t * backend)
+{
+    flash_log_backend = backend;
+    flash_log_sectors = backend->size / FLASH_SECTOR_SIZE;
+    flash_log_stats = (flash_log_stats_t) {0};
+    memset(flash_log_page, 0xff, FLASH_PAGE_SIZE);
+
+    if (flash_log_sectors < 2)
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    // Recovery only reads one header per sector and then the records of the newest sector.
+    bool is_found = false;
+
+    for (uint32_t sector = 0; sector < flash_log_sectors; sector++)
+    {
+        uint32_t sequence;
+
+        if (flash_log_sector_is_valid(sector, &sequence) && (!is_found || (int32_t) (sequence - flash_log_sequence) > 0))
+        {
+            flash_log_sector = sector;
+            flash_log_sequence = sequence;
+            is_found = true;
+        }
+    }
+
+    if (!is_found)
+    {
+        // Empty log, start on the last sector so the first record opens sector 0.
+        flash_log_sector = flash_log_sectors - 1;
+        flash_log_sequence = 0;
+        flash_log_position = FLASH_SECTOR_SIZE;
+        flash_log_flushed = 0;
+        return PICO_OK;
+    }
+
+    uint32_t offset = sizeof(flash_log_sector_header_t);
+    uint16_t length;
+
+    while ((length = flash_log_record_at(flash_log_sector, offset)) != 0)
+    {
+        offset += flash_log_record_size(length);
+    }
+
+    const flash_log_record_header_t * end = (const flash_log_record_header_t *) (flash_log_backend->base + flash_log_sector * FLASH_SECTOR_SIZE + offset);
+
+    if (offset + sizeof(flash_log_record_header_t) <= FLASH_SECTOR_SIZE && (end->length != 0xffff || end->check != 0xffff))
+    {
+        // A torn record from a power loss, leave the rest of this sector alone.
+        offset = FLASH_SECTOR_SIZE;
+    }
+
+    // Reload the partly written page so appends continue in it.
+    flash_log_position = offset;
+    flash_log_flushed = offset & (FLASH_PAGE_SIZE - 1);
+
+    if (offset < FLASH_SECTOR_SIZE)
+    {
+        memcpy(flash_log_page, flash_log_backend->base + flash_log_sector * FLASH_SECTOR_SIZE + (offset & ~(FLASH_PAGE_SIZE - 1)), flash_log_flushed);
+    }
+
+    return PICO_OK;
+}
+
+// Makes room for a record of length bytes, which is then written as its header, its data
+// and the padding from flash_log_end_record.
+static int flash_log_begin_record(uint16_t length)
+{
+    if (!flash_log_backend)
+    {
+        return PICO_ERROR_NOT_PERMITTED;
+    }
+
+    if (length == 0 || length > FLASH_LOG_MAX_RECORD)
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    if (flash_log_position + flash_log_record_size(length) > FLASH_SECTOR_SIZE)
+    {
+        return flash_log_open_next_sector();
+    }
+
+    return PICO_OK;
+}
+
+// Header and data bytes, which the CRC covers.
+static int flash_log_write_record_bytes(const uint8_t * data, uint32_t count)
+{
+    flash_log_record_crc = flash_log_crc32(flash_log_record_crc, data, count);
+    return flash_log_write_bytes(data, count);
+}
+
+static int flash_log_write_record_header(uint16_t length)
+{
+    flash_log_record_header_t header = {length, ~length};
+    flash_log_record_crc = 0;
+    return flash_log_write_record_bytes((const uint8_t *) &header, sizeof(header));
+}
+
+static int flash_log_end_record(uint16_t length, int result)
+{
+    uint32_t crc = flash_log_record_crc;
+
+    if (result == PICO_OK)
+    {
+        result = flash_log_write_bytes((const uint8_t *) &crc, sizeof(crc));
+    }
+
+    if (result == PICO_OK)
+    {
+        result = flash_log_write_bytes(NULL, flash_log_record_size(length) - sizeof(flash_log_record_header_t) - length - sizeof(crc));
+    }
+
+    flash_log_stats.records_written++;
+    return result;
+}
+
+int flash_log_append(const void * data, uint16_t length)
+{
+    int result = flash_log_begin_record(length);
+
+    if (result != PICO_OK)
+    {
+        return result;
+    }
+
+    result = flash_log_write_record_header(length);
+
+    if (result == PICO_OK)
+    {
+        result = flash_log_write_record_bytes(data, length);
+    }
+
+    return flash_log_end_record(length, result);
+}
+
+int flash_log_append_packed(const uint16_t * samples, uint16_t count)
+{
+    uint32_t length = PACK12_BYTES(count);
+
+    if (length > FLASH_LOG_MAX_RECORD)
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    int result = flash_log_begin_record(length);
+
+    if (result != PICO_OK)
+    {
+        return result;
+    }
+
+    result = flash_log_write_record_header(length);
+
+    // Packed a chunk at a time straight into the page, the record is never whole in RAM.
+    uint32_t chunk[24];
+
+    for (uint16_t i = 0; i < count && result == PICO_OK; i += 64)
+    {
+        size_t bytes = pack12_block(samples + i, chunk, count - i < 64 ? count - i : 64);
+        result = flash_log_write_record_bytes((const uint8_t *) chunk, bytes);
+    }
+
+    return flash_log_end_record(length, result);
+}
+
+int flash_log_flush()
+{
+    uint32_t in_page = flash_log_position & (FLASH_PAGE_SIZE - 1);
+
+    if (!flash_log_backend || in_page == flash_log_flushed || flash_log_position >= FLASH_SECTOR_SIZE)
+    {
+        return PICO_OK;
+    }
+
+    int result = flash_log_program_page();
+    flash_log_flushed = in_page;
+
+    return result;
+}
+
+void flash_log_begin(flash_log_iterator_t * iterator)
+{
+    // The sector after the newest one is the oldest once the log has wrapped, erased before.
+    iterator->sector = (flash_log_sector + 1) % flash_log_sectors;
+    iterator->offset = 0;
+    iterator->sectors_left = flash_log_sectors;
+}
+
+bool flash_log_next(flash_log_iterator_t * iterator, const uint8_t ** data, uint16_t * length)
+{
+    while (iterator->sectors_left)
+    {
+        uint32_t sequence;
+
+        if (iterator->offset == 0)
+        {
+            if (!flash_log_sector_is_valid(iterator->sector, &sequence))
+            {
+                iterator->offset = FLASH_SECTOR_SIZE;
+            }
+
+            else
+            {
+                iterator->offset = sizeof(flash_log_sector_header_t);
+            }
+        }
+
+        uint16_t record_length = iterator->offset < FLASH_SECTOR_SIZE ? flash_log_record_at(iterator->sector, iterator->offset) : 0;
+
+        if (record_length)
+        {
+            // Records are read in place through the memory mapped view, nothing is copied.
+            *data = flash_log_backend->base + iterator->sector * FLASH_SECTOR_SIZE + iterator->offset + sizeof(flash_log_record_header_t);
+            *length = record_length;
+            iterator->offset += flash_log_record_size(record_length);
+            return true;
+        }
+
+        iterator->sector = (iterator->sector + 1) % flash_log_sectors;
+        iterator->offset = 0;
+        iterator->sectors_left--;
+    }
+
+    return false;
+}
+
+void flash_log_get_stats(flash_log_stats_t * stats)
+{
+    *stats = flash_log_stats;
+    stats->sequence = flash_log_sequence;
+}
+
+#pragma endregion
@@ -0,0 +1,55 @@
+#ifndef PICO_LIBRARY_FLASH_LOG_H_
+#define PICO_LIBRARY_FLASH_LOG_H_
+
+#include "portable.h"
+#include "pack12.h"
+
+// Flash log functions
+// Append-only record log over whole flash sectors. Sectors are written round robin and
+// start with a sequence number, records are batched in a RAM page and reach flash once the
+// page fills or on flash_log_flush. A record is its length and ~length, the data and a
+// CRC-32 of both, so a record torn by a power loss is rejected even when its header made
+// it to flash. Flash access goes through a backend, flash_log_init for the Pico's own
+// flash, or a file in the host test. Records from flash_log_append_packed hold
+// PACK12_COUNT(length) packed samples.
+#ifndef FLASH_PAGE_SIZE
+    #define FLASH_PAGE_SIZE (1u << 8)
+#endif
+#ifndef FLASH_SECTOR_SIZE
+    #define FLASH_SECTOR_SIZE (1u << 12)
+#endif
+#define FLASH_LOG_MAGIC 0x32474c50 // "PLG2"
+#define FLASH_LOG_MAX_RECORD (FLASH_SECTOR_SIZE - 16)
+
+typedef struct
+{
+    const uint8_t * base; // Memory mapped view of the log region
+    uint32_t size;
+    int (*erase_sector)(uint32_t offset);
+    int (*program_page)(uint32_t offset, const uint8_t * data);
+} flash_log_backend_t;
+
+typedef struct
+{
+    uint32_t sector;
+    uint32_t offset;
+    uint32_t sectors_left;
+} flash_log_iterator_t;
+
+typedef struct
+{
+    uint32_t records_written;
+    uint32_t pages_programmed;
+    uint32_t sectors_erased;
+    uint32_t sequence;
+} flash_log_stats_t;
+
+int flash_log_init_with_backend(const flash_log_backend_t * backend);
+int flash_log_append(const void * data, uint16_t length);
+int flash_log_append_packed(const uint16_t * samples, uint16_t count);
+int flash_log_flush();
+void flash_log_begin(flash_log_iterator_t * iterator);
+bool flash_log_next(flash_log_iterator_t * iterator, const uint8_t ** data, uint16_t * length);
+void flash_log_get_stats(flash_log_stats_t * stats);
+
+#endif
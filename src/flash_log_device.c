@@ -0,0 +1,47 @@
+#include "PicoLibrary.h"
+
+#pragma region Flash Log Device Functions
+
+typedef struct
+{
+    uint32_t offset;
+    const uint8_t * data;
+} flash_log_program_t;
+
+static void __not_in_flash_func(flash_log_erase_callback)(void * param)
+{
+    flash_range_erase(FLASH_LOG_OFFSET + (uint32_t) (uintptr_t) param, FLASH_SECTOR_SIZE);
+}
+
+static void __not_in_flash_func(flash_log_program_callback)(void * param)
+{
+    const flash_log_program_t * program = param;
+    flash_range_program(FLASH_LOG_OFFSET + program->offset, program->data, FLASH_PAGE_SIZE);
+}
+
+static int flash_log_device_erase(uint32_t offset)
+{
+    // Parks the other core and disables interrupts while flash is unavailable for XIP.
+    return flash_safe_execute(flash_log_erase_callback, (void *) (uintptr_t) offset, FLASH_LOG_TIMEOUT_MS);
+}
+
+static int flash_log_device_program(uint32_t offset, const uint8_t * data)
+{
+    flash_log_program_t program = {offset, data};
+    return flash_safe_execute(flash_log_program_callback, &program, FLASH_LOG_TIMEOUT_MS);
+}
+
+const flash_log_backend_t flash_log_device_backend =
+{
+    (const uint8_t *) (XIP_BASE + FLASH_LOG_OFFSET),
+    FLASH_LOG_SIZE,
+    flash_log_device_erase,
+    flash_log_device_program
+};
+
+int flash_log_init()
+{
+    return flash_log_init_with_backend(&flash_log_device_backend);
+}
+
+#pragma endregion
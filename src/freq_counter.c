@@ -0,0 +1,277 @@
+#include "PicoLibrary.h"
+
+#pragma region Frequency Counter Functions
+
+repeating_timer_t freq_counter_timer;
+enum freq_counter_mode_enum freq_counter_mode;
+uint8_t freq_counter_pin;
+uint8_t freq_counter_source;
+uint32_t freq_counter_runs;
+uint32_t freq_counter_gate_us;
+uint64_t freq_counter_start_us;
+uint64_t freq_counter_sum;          // FC0 results in 1/32 kHz, or period cycles
+uint32_t freq_counter_samples;
+uint32_t freq_counter_last_periods;
+volatile bool is_freq_counter_running = false;
+bool is_freq_counter_started = false;
+
+static void freq_counter_fc0_start(uint8_t source, uint8_t interval)
+{
+    fc_hw_t * fc = &clocks_hw->fc0;
+
+    while (fc->status & CLOCKS_FC0_STATUS_RUNNING_BITS)
+    {
+        tight_loop_contents();
+    }
+
+    fc->ref_khz = clock_get_hz(clk_ref) / 1000;
+    fc->interval = interval;
+    fc->min_khz = 0;
+    fc->max_khz = 0xffffffff;
+    fc->src = source; // Starts the count
+}
+
+static bool PICO_LIBRARY_HOT(freq_counter_timer_callback)(repeating_timer_t * timer)
+{
+    if (freq_counter_mode == FREQ_COUNTER_RECIPROCAL)
+    {
+        pulse_measure_result_t result;
+
+        // Every period at low frequencies, a sample of them at higher ones.
+        if (pulse_measure_get(freq_counter_pin, &result) && result.periods != freq_counter_last_periods)
+        {
+            freq_counter_sum += (uint64_t) result.high_cycles + result.low_cycles;
+            freq_counter_samples++;
+            freq_counter_last_periods = result.periods;
+        }
+
+        if (time_us_64() - freq_counter_start_us < freq_counter_gate_us)
+        {
+            return true;
+        }
+    }
+
+    else
+    {
+        fc_hw_t * fc = &clocks_hw->fc0;
+
+        if (!(fc->status & CLOCKS_FC0_STATUS_DONE_BITS))
+        {
+            return true;
+        }
+
+        freq_counter_sum += fc->result & (CLOCKS_FC0_RESULT_KHZ_BITS | CLOCKS_FC0_RESULT_FRAC_BITS);
+        freq_counter_samples++;
+
+        if (freq_counter_samples < freq_counter_runs)
+        {
+            fc->src = freq_counter_source;
+            return true;
+        }
+    }
+
+    freq_counter_gate_us = time_us_64() - freq_counter_start_us;
+
+    if (freq_counter_mode != FREQ_COUNTER_RECIPROCAL)
+    {
+        cpu_clock_fc0_unclaim();
+    }
+
+    is_freq_counter_running = false;
+    return false;
+}
+
+int freq_counter_start(uint8_t pin, uint32_t gate_us, enum freq_counter_mode_enum mode)
+{
+    bool is_gpin = pin == FREQ_COUNTER_GPIN0_PIN || pin == FREQ_COUNTER_GPIN1_PIN;
+
+    if (pin >= NUM_BANK0_GPIOS || gate_us == 0 || (mode != FREQ_COUNTER_RECIPROCAL && !is_gpin))
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    freq_counter_cancel();
+
+    // Held for the whole gate, FC0 is restarted between intervals.
+    if (mode != FREQ_COUNTER_RECIPROCAL && !cpu_clock_fc0_claim())
+    {
+        return PICO_ERROR_RESOURCE_IN_USE;
+    }
+
+    freq_counter_pin = pin;
+    freq_counter_source = pin == FREQ_COUNTER_GPIN0_PIN ? CLOCKS_FC0_SRC_VALUE_CLKSRC_GPIN0 : CLOCKS_FC0_SRC_VALUE_CLKSRC_GPIN1;
+    freq_counter_sum = 0;
+    freq_counter_samples = 0;
+    freq_counter_last_periods = 0;
+
+    if (is_gpin)
+    {
+        gpio_set_function(pin, GPIO_FUNC_GPCK);
+    }
+
+    // A 1 ms count, 1 kHz resolution, is enough to pick the better method.
+    if (mode == FREQ_COUNTER_AUTO)
+    {
+        freq_counter_fc0_start(freq_counter_source, 10);
+
+        while (!(clocks_hw->fc0.status & CLOCKS_FC0_STATUS_DONE_BITS))
+        {
+            tight_loop_contents();
+        }
+
+        uint32_t khz = clocks_hw->fc0.result >> CLOCKS_FC0_RESULT_KHZ_LSB;
+        mode = khz * 1000 < FREQ_COUNTER_RECIPROCAL_BELOW_HZ ? FREQ_COUNTER_RECIPROCAL : FREQ_COUNTER_DIRECT;
+
+        if (mode == FREQ_COUNTER_RECIPROCAL)
+        {
+            cpu_clock_fc0_unclaim();
+        }
+    }
+
+    freq_counter_mode = mode;
+    int64_t tick_us;
+
+    if (mode == FREQ_COUNTER_RECIPROCAL)
+    {
+        int result = pulse_measure_start(pin);
+
+        if (result != PICO_OK)
+        {
+            return result;
+        }
+
+        tick_us = FREQ_COUNTER_RECIPROCAL_TICK_US;
+    }
+
+    else
+    {
+        // The longest interval that fits the gate, repeated to fill it. An interval is
+        // 0.98 us * 2^interval.
+        uint8_t interval = 0;
+
+        while (interval < 15 && (((uint64_t) 98 << (interval + 1)) / 100) <= gate_us)
+        {
+            interval++;
+        }
+
+        uint32_t interval_us = ((98u << interval) + 99) / 100;
+        freq_counter_runs = (gate_us + interval_us - 1) / interval_us;
+        tick_us = interval_us + 2; // Polled just after each count ends
+        freq_counter_fc0_start(freq_counter_source, interval);
+    }
+
+    freq_counter_start_us = time_us_64();
+    freq_counter_gate_us = gate_us;
+    is_freq_counter_running = true;
+
+    // A negative delay keeps the period fixed regardless of how long the callback takes.
+    if (!add_repeating_timer_us(-tick_us, freq_counter_timer_callback, NULL, &freq_counter_timer))
+    {
+        if (mode == FREQ_COUNTER_RECIPROCAL)
+        {
+            pulse_measure_stop(pin);
+        }
+
+        if (mode != FREQ_COUNTER_RECIPROCAL)
+        {
+            cpu_clock_fc0_unclaim();
+        }
+
+        is_freq_counter_running = false;
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+
+    is_freq_counter_started = true;
+    return PICO_OK;
+}
+
+bool freq_counter_is_done()
+{
+    return is_freq_counter_started && !is_freq_counter_running;
+}
+
+int freq_counter_get_result(freq_counter_result_t * result)
+{
+    if (!is_freq_counter_started)
+    {
+        return PICO_ERROR_NOT_PERMITTED;
+    }
+
+    if (is_freq_counter_running)
+    {
+        return PICO_ERROR_NO_DATA;
+    }
+
+    // Stopped here rather than from the timer, outside interrupt context.
+    if (freq_counter_mode == FREQ_COUNTER_RECIPROCAL)
+    {
+        pulse_measure_stop(freq_counter_pin);
+    }
+
+    result->samples = freq_counter_samples;
+    result->gate_us = freq_counter_gate_us;
+    result->mode = freq_counter_mode;
+
+    // No whole period inside the gate.
+    if (freq_counter_samples == 0 || freq_counter_sum == 0)
+    {
+        result->hz = 0;
+        return PICO_ERROR_TIMEOUT;
+    }
+
+    if (freq_counter_mode == FREQ_COUNTER_RECIPROCAL)
+    {
+        result->hz = (double) clock_get_hz(clk_sys) * freq_counter_samples / freq_counter_sum;
+    }
+
+    else
+    {
+        result->hz = freq_counter_sum * (1000.0 / 32) / freq_counter_samples;
+    }
+
+    return PICO_OK;
+}
+
+void freq_counter_cancel()
+{
+    if (!is_freq_counter_started)
+    {
+        return;
+    }
+
+    cancel_repeating_timer(&freq_counter_timer);
+
+    if (freq_counter_mode == FREQ_COUNTER_RECIPROCAL)
+    {
+        pulse_measure_stop(freq_counter_pin);
+    }
+
+    else if (is_freq_counter_running)
+    {
+        cpu_clock_fc0_unclaim();
+    }
+
+    is_freq_counter_running = false;
+    is_freq_counter_started = false;
+}
+
+double freq_counter_measure(uint8_t pin, uint32_t gate_us, enum freq_counter_mode_enum mode)
+{
+    freq_counter_result_t result;
+
+    if (freq_counter_start(pin, gate_us, mode) != PICO_OK)
+    {
+        return 0;
+    }
+
+    while (!freq_counter_is_done())
+    {
+        tight_loop_contents();
+    }
+
+    freq_counter_get_result(&result);
+    freq_counter_cancel();
+    return result.hz;
+}
+
+#pragma endregion
@@ -0,0 +1,83 @@
+#include "PicoLibrary.h"
+
+// With PICO_LIBRARY_INLINE these are defined in PicoLibrary.h instead.
+#ifndef PICO_LIBRARY_INLINE
+
+#pragma region GPIO Functions
+
+void PICO_LIBRARY_HOT(gpio_pins_change_all)(uint32_t function)
+{
+    gpio_put_all(function);
+}
+
+void PICO_LIBRARY_HOT(gpio_pins_set_all_directions)(uint32_t value)
+{
+    gpio_set_dir_all_bits(value);
+}
+
+void gpio_pin_set_function(uint8_t pin, gpio_function_t function)
+{
+    if (!is_gpio_init)
+    {
+        gpio_init(pin);
+        is_gpio_init = true;
+    }
+
+    gpio_set_function(pin, function);
+}
+
+void gpio_pin_disable_pulls(uint8_t pin)
+{
+    if (!is_gpio_init)
+    {
+        gpio_init(pin);
+        is_gpio_init = true;
+    }
+
+    gpio_disable_pulls(pin);
+}
+
+void gpio_pin_set_input_output(uint8_t pin, bool is_input)
+{
+    if (!is_gpio_init)
+    {
+        gpio_init(pin);
+        is_gpio_init = true;
+    }
+
+    gpio_set_input_enabled(pin, is_input);
+}
+
+void gpio_pin_set_mode(uint8_t pin, bool high_voltage)
+{
+    if (!is_gpio_init)
+    {
+        gpio_init(pin);
+        is_gpio_init = true;
+    }
+
+    if (high_voltage)
+    {
+        gpio_pull_up(pin);
+    }
+
+    else
+    {
+        gpio_pull_down(pin);
+    }
+}
+
+void PICO_LIBRARY_HOT(gpio_pin_set_high_low)(uint8_t pin, bool is_high)
+{
+    if (!is_gpio_init)
+    {
+        gpio_init(pin);
+        is_gpio_init = true;
+    }
+
+    gpio_put(pin, is_high);
+}
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,77 @@
+#include "PicoLibrary.h"
+
+#ifdef CYW43_WL_GPIO_LED_PIN
+    bool is_pico_w = true;
+#elif defined(PICO_DEFAULT_LED_PIN)
+    bool is_pico_w = false;
+#endif
+
+bool is_led_init = false;
+bool is_adc_init = false;
+bool is_gpio_init = false;
+bool is_pico_w_init = false;
+
+uint8_t temp_used_adc_gpio_pins[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+uint8_t * used_adc_gpio_pins = temp_used_adc_gpio_pins;
+uint8_t temp_adc_gpio_index = 0;
+uint8_t adc_input_init_mask = 0; // Bit n set once ADC input n is initialised
+
+#pragma region Initialisation Functions
+
+void led_init()
+{
+    if (!is_led_init)
+    {
+        #if defined(PICO_DEFAULT_LED_PIN)
+            // A device like Pico that uses a GPIO for the LED will define PICO_DEFAULT_LED_PIN
+            // so we can use normal GPIO functionality to turn the led on and off.
+            gpio_init(PICO_DEFAULT_LED_PIN);
+            gpio_set_dir(PICO_DEFAULT_LED_PIN, GPIO_OUT);
+        #elif defined(CYW43_WL_GPIO_LED_PIN)
+            // For Pico W devices we need to initialise the driver, etc.
+            pico_w_gpio_init();
+        #endif
+
+        is_led_init = true;
+    }
+}
+
+void adc_library_init()
+{
+    if (!is_adc_init)
+    {
+        adc_init();
+        is_adc_init = true;
+    }
+}
+
+void adc_input_init(uint8_t adc_input)
+{
+    uint8_t pin = adc_input + 26;
+
+    adc_library_init();
+
+    // Input 4 is the onboard temperature sensor, which has no GPIO.
+    if (adc_input == 4)
+    {
+        adc_set_temp_sensor_enabled(true);
+    }
+
+    else if (!contains_uint8_t(temp_used_adc_gpio_pins, pin))
+    {
+        // Make sure GPIO is high-impedance, no pullups etc.
+        adc_gpio_init(pin);
+
+        temp_used_adc_gpio_pins[temp_adc_gpio_index++] = pin;
+    }
+
+    adc_input_init_mask |= 1u << adc_input;
+}
+
+void gpio_pin_init(uint8_t pin)
+{
+    gpio_init(pin);
+    is_gpio_init = true;
+}
+
+#pragma endregion
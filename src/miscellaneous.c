@@ -0,0 +1,88 @@
+#include "PicoLibrary.h"
+
+#pragma region Miscellaneous Functions
+
+int power_get_status(bool * is_battery_powered) 
+{
+    // Pico W uses a CYW43 pin to get VBUS, the cached reading saves an SPI transaction.
+    #if defined CYW43_WL_GPIO_VBUS_PIN
+        *is_battery_powered = !pico_w_vbus_get();
+        return PICO_OK;
+    #elif defined PICO_VBUS_PIN
+        gpio_set_function(PICO_VBUS_PIN, GPIO_FUNC_SIO);
+        *is_battery_powered = !gpio_get(PICO_VBUS_PIN);
+        return PICO_OK;
+    #else
+        return PICO_ERROR_NO_DATA;
+    #endif
+}
+
+int power_get_voltage_status(float * voltage_result, uint8_t pin, int power_sample_count) 
+{
+    // Pico W uses a CYW43 pin to get VBUS so we need to initialize it.
+    #if CYW43_USES_VSYS_PIN
+        if (!is_pico_w_init)
+        {
+            cyw43_arch_init();
+            is_pico_w_init = true;
+        }
+    #endif
+
+    #ifndef PICO_VSYS_PIN
+        return PICO_ERROR_NO_DATA;
+    #else
+    #if CYW43_USES_VSYS_PIN
+        cyw43_thread_enter();
+        // Make sure cyw43 is awake
+        cyw43_arch_gpio_get(CYW43_WL_GPIO_VBUS_PIN);
+    #endif
+
+    // setup adc
+    adc_gpio_init(PICO_VSYS_PIN);
+    adc_select_input(PICO_VSYS_PIN - pin);
+ 
+    adc_fifo_setup(true, false, 0, false, false);
+    adc_run(true);
+
+    // We seem to read low values initially - this seems to fix it
+    int ignore_count = power_sample_count;
+
+    while (!adc_fifo_is_empty() || ignore_count-- > 0) 
+    {
+        (void)adc_fifo_get_blocking();
+    }
+
+    // read vsys
+    uint32_t vsys = 0;
+
+    for(int i = 0; i < power_sample_count; i++) 
+    {
+        uint16_t val = adc_fifo_get_blocking();
+        vsys += val;
+    }
+
+    adc_run(false);
+    adc_fifo_drain();
+
+    vsys /= power_sample_count;
+    #if CYW43_USES_VSYS_PIN
+        cyw43_thread_exit();
+    #endif
+        // Generate voltage
+        const float conversion_factor = ADC_VOLTS_PER_CODE;
+        *voltage_result = vsys * 3 * conversion_factor;
+        return PICO_OK;
+    #endif
+}
+
+void pico_w_deinit()
+{
+    #if CYW43_USES_VSYS_PIN
+        pico_w_gpio_deinit();
+        cyw43_arch_deinit();
+        is_pico_w_init = false;
+        is_led_init = false;
+    #endif
+}
+
+#pragma endregion
@@ -0,0 +1,111 @@
+#include "pack12.h"
+
+#pragma region Packed Sample Functions
+
+// Words over the uint16_t samples, marked so the compiler does not assume they never alias.
+typedef uint32_t __attribute__((may_alias)) pack12_word_t;
+
+// Two samples held in a word, s0 | s1 << 16, as 24 bits, s0 | s1 << 12.
+static inline uint32_t pack12_pair(uint32_t pair)
+{
+    pair &= 0x0fff0fff;
+    return (pair & 0xfff) | ((pair >> 4) & 0xfff000);
+}
+
+static inline uint32_t unpack12_pair(uint32_t bits)
+{
+    return (bits & 0xfff) | ((bits << 4) & 0x0fff0000);
+}
+
+size_t PICO_LIBRARY_HOT(pack12_block)(const uint16_t * samples, void * packed, size_t count)
+{
+    size_t i = 0;
+    uint8_t * output = packed;
+
+    if ((((uintptr_t) samples | (uintptr_t) packed) & 3) == 0)
+    {
+        const pack12_word_t * pairs = (const pack12_word_t *) samples;
+        pack12_word_t * words = packed;
+
+        // All four pairs are read before the three words are written, so in place is safe.
+        for (; i + 8 <= count; i += 8)
+        {
+            uint32_t q0 = pack12_pair(pairs[0]);
+            uint32_t q1 = pack12_pair(pairs[1]);
+            uint32_t q2 = pack12_pair(pairs[2]);
+            uint32_t q3 = pack12_pair(pairs[3]);
+            pairs += 4;
+
+            words[0] = q0 | (q1 << 24);
+            words[1] = (q1 >> 8) | (q2 << 16);
+            words[2] = (q2 >> 16) | (q3 << 8);
+            words += 3;
+        }
+
+        output = (uint8_t *) words;
+    }
+
+    for (; i + 2 <= count; i += 2)
+    {
+        uint16_t s0 = samples[i] & 0xfff;
+        uint16_t s1 = samples[i + 1] & 0xfff;
+
+        output[0] = s0;
+        output[1] = (s0 >> 8) | (s1 << 4);
+        output[2] = s1 >> 4;
+        output += 3;
+    }
+
+    if (i < count)
+    {
+        uint16_t s0 = samples[i] & 0xfff;
+
+        output[0] = s0;
+        output[1] = s0 >> 8;
+        output += 2;
+    }
+
+    return output - (uint8_t *) packed;
+}
+
+void PICO_LIBRARY_HOT(unpack12_block)(const void * packed, uint16_t * samples, size_t count)
+{
+    size_t i = 0;
+    const uint8_t * input = packed;
+
+    if ((((uintptr_t) samples | (uintptr_t) packed) & 3) == 0)
+    {
+        const pack12_word_t * words = packed;
+        pack12_word_t * pairs = (pack12_word_t *) samples;
+
+        for (; i + 8 <= count; i += 8)
+        {
+            uint32_t w0 = words[0];
+            uint32_t w1 = words[1];
+            uint32_t w2 = words[2];
+            words += 3;
+
+            pairs[0] = unpack12_pair(w0);
+            pairs[1] = unpack12_pair((w0 >> 24) | (w1 << 8));
+            pairs[2] = unpack12_pair((w1 >> 16) | (w2 << 16));
+            pairs[3] = unpack12_pair(w2 >> 8);
+            pairs += 4;
+        }
+
+        input = (const uint8_t *) words;
+    }
+
+    for (; i + 2 <= count; i += 2)
+    {
+        samples[i] = input[0] | ((input[1] & 0xf) << 8);
+        samples[i + 1] = (input[1] >> 4) | (input[2] << 4);
+        input += 3;
+    }
+
+    if (i < count)
+    {
+        samples[i] = input[0] | ((input[1] & 0xf) << 8);
+    }
+}
+
+#pragma endregion
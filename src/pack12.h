@@ -0,0 +1,19 @@
+#ifndef PICO_LIBRARY_PACK12_H_
+#define PICO_LIBRARY_PACK12_H_
+
+#include "portable.h"
+
+// Packed sample functions
+// 12-bit samples stored two to three bytes, a quarter less than uint16_t. The stream is
+// little-endian and least significant bit first, so sample n is bits 12n to 12n + 11, read
+// as pairs: b0 | (b1 & 0xf) << 8, then b1 >> 4 | b2 << 4. With both buffers word aligned,
+// eight samples go through three words at a time, otherwise bytes, on the Pico and on
+// little-endian hosts alike. Packing may be done in place. Bits above the 12th, like the
+// ADC FIFO's error flag, are dropped.
+#define PACK12_BYTES(count) (((count) * 3 + 1) / 2)
+#define PACK12_COUNT(bytes) ((bytes) * 2 / 3)
+
+size_t PICO_LIBRARY_HOT(pack12_block)(const uint16_t * samples, void * packed, size_t count);
+void PICO_LIBRARY_HOT(unpack12_block)(const void * packed, uint16_t * samples, size_t count);
+
+#endif
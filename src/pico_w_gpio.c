@@ -0,0 +1,204 @@
+#include "PicoLibrary.h"
+
+// Only Pico W has the CYW43 chip.
+#ifdef CYW43_WL_GPIO_LED_PIN
+
+#pragma region Pico W GPIO Functions
+
+volatile uint32_t pico_w_gpio_shadow = 0;       // Values last asked for
+volatile uint32_t pico_w_gpio_set_mask = 0;     // GPIOs that have been asked for at all
+volatile uint32_t pico_w_gpio_pending = 0;      // GPIOs the worker still has to write
+uint32_t pico_w_gpio_written = 0;               // Values on the chip
+uint32_t pico_w_gpio_written_mask = 0;          // GPIOs whose chip value is known
+volatile bool pico_w_vbus = false;
+volatile bool is_pico_w_vbus_valid = false;
+volatile bool is_pico_w_vbus_refresh = false;
+bool is_pico_w_gpio_init = false;
+pico_w_gpio_stats_t pico_w_gpio_stats;
+
+static void pico_w_vbus_read()
+{
+    bool value = false;
+
+    if (cyw43_gpio_get(&cyw43_state, CYW43_WL_GPIO_VBUS_PIN, &value) == 0)
+    {
+        pico_w_vbus = value;
+        is_pico_w_vbus_valid = true;
+    }
+
+    pico_w_gpio_stats.vbus_reads++;
+}
+
+// Both workers run in the cyw43 async context with its lock held, so they can talk to
+// the chip directly.
+static void pico_w_gpio_work(async_context_t * context, async_when_pending_worker_t * worker)
+{
+    uint32_t save = save_and_disable_interrupts();
+    uint32_t pending = pico_w_gpio_pending;
+    uint32_t shadow = pico_w_gpio_shadow;
+    bool is_refresh = is_pico_w_vbus_refresh;
+    pico_w_gpio_pending = 0;
+    is_pico_w_vbus_refresh = false;
+    restore_interrupts(save);
+
+    for (uint8_t wl_gpio = 0; wl_gpio < PICO_W_GPIO_COUNT; wl_gpio++)
+    {
+        uint32_t bit = 1u << wl_gpio;
+
+        // A GPIO changed and changed back before this ran needs no transaction.
+        if (!(pending & bit) || ((pico_w_gpio_written_mask & bit) && !((pico_w_gpio_written ^ shadow) & bit)))
+        {
+            continue;
+        }
+
+        cyw43_gpio_set(&cyw43_state, wl_gpio, shadow & bit);
+        pico_w_gpio_written = (pico_w_gpio_written & ~bit) | (shadow & bit);
+        pico_w_gpio_written_mask |= bit;
+        pico_w_gpio_stats.transactions++;
+    }
+
+    if (is_refresh)
+    {
+        pico_w_vbus_read();
+    }
+}
+
+static void pico_w_vbus_work(async_context_t * context, async_at_time_worker_t * worker)
+{
+    pico_w_vbus_read();
+    async_context_add_at_time_worker_in_ms(context, worker, PICO_W_VBUS_REFRESH_MS);
+}
+
+async_when_pending_worker_t pico_w_gpio_worker = {.do_work = pico_w_gpio_work};
+async_at_time_worker_t pico_w_vbus_worker = {.do_work = pico_w_vbus_work};
+
+int pico_w_gpio_init()
+{
+    if (is_pico_w_gpio_init)
+    {
+        return PICO_OK;
+    }
+
+    if (!is_pico_w_init)
+    {
+        if (cyw43_arch_init() != 0)
+        {
+            return PICO_ERROR_GENERIC;
+        }
+
+        is_pico_w_init = true;
+    }
+
+    async_context_t * context = cyw43_arch_async_context();
+    async_context_add_when_pending_worker(context, &pico_w_gpio_worker);
+    async_context_add_at_time_worker_in_ms(context, &pico_w_vbus_worker, 0);
+    is_pico_w_gpio_init = true;
+    return PICO_OK;
+}
+
+void PICO_LIBRARY_HOT(pico_w_gpio_put)(uint8_t wl_gpio, bool value)
+{
+    if (!is_pico_w_gpio_init)
+    {
+        pico_w_gpio_init();
+    }
+
+    uint32_t bit = 1u << wl_gpio;
+    uint32_t save = save_and_disable_interrupts();
+    uint32_t shadow = value ? pico_w_gpio_shadow | bit : pico_w_gpio_shadow & ~bit;
+    bool is_change = shadow != pico_w_gpio_shadow || !(pico_w_gpio_set_mask & bit);
+
+    pico_w_gpio_shadow = shadow;
+    pico_w_gpio_set_mask |= bit;
+    pico_w_gpio_stats.writes++;
+
+    if (is_change)
+    {
+        pico_w_gpio_pending |= bit;
+    }
+
+    else
+    {
+        pico_w_gpio_stats.skipped_writes++;
+    }
+
+    restore_interrupts(save);
+
+    if (is_change)
+    {
+        async_context_set_work_pending(cyw43_arch_async_context(), &pico_w_gpio_worker);
+    }
+}
+
+bool pico_w_gpio_get_shadow(uint8_t wl_gpio)
+{
+    return pico_w_gpio_shadow & (1u << wl_gpio);
+}
+
+void pico_w_gpio_flush()
+{
+    // Not from the async context itself, or with interrupts off under the background arch.
+    while (pico_w_gpio_pending != 0)
+    {
+        cyw43_arch_poll();
+        tight_loop_contents();
+    }
+}
+
+bool pico_w_vbus_get()
+{
+    if (!is_pico_w_gpio_init)
+    {
+        pico_w_gpio_init();
+    }
+
+    // Only the first call waits, for the first reading.
+    if (!is_pico_w_vbus_valid)
+    {
+        cyw43_thread_enter();
+        pico_w_vbus_read();
+        cyw43_thread_exit();
+    }
+
+    return pico_w_vbus;
+}
+
+void pico_w_vbus_refresh()
+{
+    if (!is_pico_w_gpio_init)
+    {
+        pico_w_gpio_init();
+    }
+
+    is_pico_w_vbus_refresh = true;
+    async_context_set_work_pending(cyw43_arch_async_context(), &pico_w_gpio_worker);
+}
+
+void pico_w_gpio_deinit()
+{
+    if (!is_pico_w_gpio_init)
+    {
+        return;
+    }
+
+    async_context_t * context = cyw43_arch_async_context();
+    async_context_remove_when_pending_worker(context, &pico_w_gpio_worker);
+    async_context_remove_at_time_worker(context, &pico_w_vbus_worker);
+
+    pico_w_gpio_set_mask = 0;
+    pico_w_gpio_pending = 0;
+    pico_w_gpio_written_mask = 0;
+    is_pico_w_vbus_valid = false;
+    is_pico_w_gpio_init = false;
+}
+
+void pico_w_gpio_get_stats(pico_w_gpio_stats_t * stats)
+{
+    uint32_t save = save_and_disable_interrupts();
+    *stats = pico_w_gpio_stats;
+    restore_interrupts(save);
+}
+
+#pragma endregion
+
+#endif
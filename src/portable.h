@@ -0,0 +1,74 @@
+#ifndef PICO_LIBRARY_PORTABLE_H_
+#define PICO_LIBRARY_PORTABLE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// The subsystems with a header in src/ do not touch the hardware, so they build into
+// pico_library and, with PICO_LIBRARY_HOST defined, into the host tools and tests in
+// host/. This is everything they need from the SDK.
+#ifdef PICO_LIBRARY_HOST
+    #include <time.h>
+
+    // The values of pico/error.h, host tools decode them from replies and records.
+    enum pico_error_codes
+    {
+        PICO_OK = 0,
+        PICO_ERROR_NONE = 0,
+        PICO_ERROR_GENERIC = -1,
+        PICO_ERROR_TIMEOUT = -2,
+        PICO_ERROR_NO_DATA = -3,
+        PICO_ERROR_NOT_PERMITTED = -4,
+        PICO_ERROR_INVALID_ARG = -5,
+        PICO_ERROR_IO = -6,
+        PICO_ERROR_BADAUTH = -7,
+        PICO_ERROR_CONNECT_FAILED = -8,
+        PICO_ERROR_INSUFFICIENT_RESOURCES = -9,
+        PICO_ERROR_INVALID_ADDRESS = -10,
+        PICO_ERROR_BAD_ALIGNMENT = -11,
+        PICO_ERROR_INVALID_STATE = -12,
+        PICO_ERROR_BUFFER_TOO_SMALL = -13,
+        PICO_ERROR_PRECONDITION_NOT_MET = -14,
+        PICO_ERROR_MODIFIED_DATA = -15,
+        PICO_ERROR_INVALID_DATA = -16,
+        PICO_ERROR_NOT_FOUND = -17,
+        PICO_ERROR_UNSUPPORTED_MODIFICATION = -18,
+        PICO_ERROR_LOCK_REQUIRED = -19,
+        PICO_ERROR_VERSION_MISMATCH = -20,
+        PICO_ERROR_RESOURCE_IN_USE = -21
+    };
+
+    #ifndef __aligned
+        #define __aligned(x) __attribute__((aligned(x)))
+    #endif
+
+    static inline uint64_t time_us_64()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return (uint64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+    }
+#else
+    #include "pico.h"
+    #include "pico/time.h"
+#endif
+
+// PICO_LIBRARY_HOT_PATHS picks where functions marked PICO_LIBRARY_HOT run from:
+// 0 keeps them in flash behind the XIP cache and 1 (the default) copies them to SRAM.
+// Work on either core is placed the same way. A scratch bank is only 4 KB and also holds
+// a core's stack, so the hot paths are not placed there.
+#ifndef PICO_LIBRARY_HOT_PATHS
+    #define PICO_LIBRARY_HOT_PATHS 1
+#endif
+
+#if defined(PICO_LIBRARY_HOST) || PICO_LIBRARY_HOT_PATHS == 0
+    #define PICO_LIBRARY_HOT(func) func
+#elif PICO_LIBRARY_HOT_PATHS == 1
+    #define PICO_LIBRARY_HOT(func) __not_in_flash_func(func)
+#else
+    #error "PICO_LIBRARY_HOT_PATHS is 0 (flash) or 1 (SRAM)"
+#endif
+
+#endif
@@ -0,0 +1,257 @@
+#include "PicoLibrary.h"
+#include "hardware/pio.h"
+#include "pulse_measure.pio.h"
+
+#pragma region Pulse Measurement Functions
+
+// An even count, so the write ring is back at the high time when a channel is restarted.
+#define PULSE_MEASURE_TRANSFERS 0xfffffffe
+
+typedef struct
+{
+    PIO pio;
+    uint sm;
+    int dma_channel;
+    uint32_t restarts;
+    uint32_t last_periods;
+    uint64_t last_period_us;    // When pulse_measure_get first saw last_periods
+    bool is_active;
+} pulse_measure_slot_t;
+
+// Raw x and y as the state machines push them, zero until the first period ends.
+uint32_t pulse_measure_table[PULSE_MEASURE_MAX_PINS][2] __aligned(8);
+pulse_measure_slot_t pulse_measure_slots[PULSE_MEASURE_MAX_PINS];
+uint8_t pulse_measure_pin_slots[NUM_BANK0_GPIOS];   // Slot + 1, 0 when not measured
+uint pulse_measure_offsets[NUM_PIOS];
+uint8_t pulse_measure_program_users[NUM_PIOS];
+uint8_t pulse_measure_active_count = 0;
+
+static void pulse_measure_dma_handler()
+{
+    for (uint8_t i = 0; i < PULSE_MEASURE_MAX_PINS; i++)
+    {
+        pulse_measure_slot_t * slot = &pulse_measure_slots[i];
+
+        if (!slot->is_active || !dma_channel_get_irq1_status(slot->dma_channel))
+        {
+            continue;
+        }
+
+        dma_channel_acknowledge_irq1(slot->dma_channel);
+        dma_channel_set_trans_count(slot->dma_channel, PULSE_MEASURE_TRANSFERS, true);
+        slot->restarts++;
+    }
+}
+
+int pulse_measure_start(uint8_t pin)
+{
+    if (pin >= NUM_BANK0_GPIOS)
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    if (pulse_measure_pin_slots[pin] != 0)
+    {
+        return PICO_OK;
+    }
+
+    uint8_t index = 0;
+
+    while (index < PULSE_MEASURE_MAX_PINS && pulse_measure_slots[index].is_active)
+    {
+        index++;
+    }
+
+    if (index == PULSE_MEASURE_MAX_PINS)
+    {
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+
+    int dma_channel = dma_claim_unused_channel(false);
+
+    if (dma_channel < 0)
+    {
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+
+    // The program is loaded once a PIO and shared by its state machines.
+    PIO pio = NULL;
+    int sm = -1;
+
+    for (uint i = 0; i < NUM_PIOS && sm < 0; i++)
+    {
+        pio = pio_get_instance(i);
+        sm = pio_claim_unused_sm(pio, false);
+
+        if (sm < 0 || pulse_measure_program_users[i] > 0)
+        {
+            continue;
+        }
+
+        if (!pio_can_add_program(pio, &pulse_measure_program))
+        {
+            pio_sm_unclaim(pio, sm);
+            sm = -1;
+            continue;
+        }
+
+        pulse_measure_offsets[i] = pio_add_program(pio, &pulse_measure_program);
+    }
+
+    if (sm < 0)
+    {
+        dma_channel_unclaim(dma_channel);
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+
+    uint pio_index = pio_get_index(pio);
+    uint offset = pulse_measure_offsets[pio_index];
+    pulse_measure_program_users[pio_index]++;
+
+    pulse_measure_slot_t * slot = &pulse_measure_slots[index];
+    slot->pio = pio;
+    slot->sm = sm;
+    slot->dma_channel = dma_channel;
+    slot->restarts = 0;
+    slot->last_periods = 0;
+    pulse_measure_table[index][0] = 0;
+    pulse_measure_table[index][1] = 0;
+
+    // Only the input is needed, the pin's function is left alone.
+    gpio_set_input_enabled(pin, true);
+
+    pio_sm_config pio_cfg = pulse_measure_program_get_default_config(offset);
+    sm_config_set_in_pins(&pio_cfg, pin);
+    sm_config_set_jmp_pin(&pio_cfg, pin);
+    sm_config_set_in_shift(&pio_cfg, false, true, 32);
+    sm_config_set_fifo_join(&pio_cfg, PIO_FIFO_JOIN_RX);
+    pio_sm_init(pio, sm, offset, &pio_cfg);
+
+    // A write ring of 8 bytes keeps each pair landing on the pin's table entry.
+    dma_channel_config cfg = dma_channel_get_default_config(dma_channel);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_32);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_ring(&cfg, true, 3);
+    channel_config_set_dreq(&cfg, pio_get_dreq(pio, sm, false));
+    dma_channel_configure(dma_channel, &cfg, pulse_measure_table[index], &pio->rxf[sm], PULSE_MEASURE_TRANSFERS, true);
+
+    if (pulse_measure_active_count++ == 0)
+    {
+        irq_add_shared_handler(DMA_IRQ_1, pulse_measure_dma_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_1, true);
+    }
+
+    dma_channel_set_irq1_enabled(dma_channel, true);
+    slot->is_active = true;
+    pulse_measure_pin_slots[pin] = index + 1;
+
+    pio_sm_set_enabled(pio, sm, true);
+    return PICO_OK;
+}
+
+void pulse_measure_stop(uint8_t pin)
+{
+    if (pin >= NUM_BANK0_GPIOS || pulse_measure_pin_slots[pin] == 0)
+    {
+        return;
+    }
+
+    pulse_measure_slot_t * slot = &pulse_measure_slots[pulse_measure_pin_slots[pin] - 1];
+    pulse_measure_pin_slots[pin] = 0;
+
+    pio_sm_set_enabled(slot->pio, slot->sm, false);
+    dma_channel_set_irq1_enabled(slot->dma_channel, false);
+    dma_channel_abort(slot->dma_channel);
+    dma_channel_acknowledge_irq1(slot->dma_channel);
+    dma_channel_unclaim(slot->dma_channel);
+    pio_sm_unclaim(slot->pio, slot->sm);
+
+    uint pio_index = pio_get_index(slot->pio);
+
+    if (--pulse_measure_program_users[pio_index] == 0)
+    {
+        pio_remove_program(slot->pio, &pulse_measure_program, pulse_measure_offsets[pio_index]);
+    }
+
+    slot->is_active = false;
+
+    if (--pulse_measure_active_count == 0)
+    {
+        irq_remove_handler(DMA_IRQ_1, pulse_measure_dma_handler);
+    }
+}
+
+// Loop counts to cycles, the extra cycles are the instructions between the samples of the
+// pin in pulse_measure.pio. A count that ran out, x or y of 0, is the longest time there is.
+static inline uint32_t pulse_measure_cycles(uint32_t count, uint32_t extra)
+{
+    uint64_t cycles = 2 * (uint64_t) ~count + extra;
+    return cycles > UINT32_MAX ? UINT32_MAX : cycles;
+}
+
+bool PICO_LIBRARY_HOT(pulse_measure_get)(uint8_t pin, pulse_measure_result_t * result)
+{
+    if (pin >= NUM_BANK0_GPIOS || pulse_measure_pin_slots[pin] == 0)
+    {
+        return false;
+    }
+
+    uint8_t index = pulse_measure_pin_slots[pin] - 1;
+    pulse_measure_slot_t * slot = &pulse_measure_slots[index];
+    uint32_t periods = slot->restarts * (PULSE_MEASURE_TRANSFERS / 2) + (PULSE_MEASURE_TRANSFERS - dma_channel_hw_addr(slot->dma_channel)->transfer_count) / 2;
+
+    if (periods == 0)
+    {
+        return false;
+    }
+
+    uint64_t now_us = time_us_64();
+
+    if (periods != slot->last_periods)
+    {
+        slot->last_periods = periods;
+        slot->last_period_us = now_us;
+    }
+
+    result->high_cycles = pulse_measure_cycles(pulse_measure_table[index][0], 3);
+    result->low_cycles = pulse_measure_cycles(pulse_measure_table[index][1], 2);
+    result->periods = periods;
+
+    // A stopped signal leaves the state machine counting and the last times in the table.
+    uint64_t period_us = ((uint64_t) result->high_cycles + result->low_cycles) / (clock_get_hz(clk_sys) / 1000000);
+    result->is_stale = now_us - slot->last_period_us > 2 * period_us + PULSE_MEASURE_STALE_MIN_US;
+    return true;
+}
+
+float pulse_measure_frequency(uint8_t pin)
+{
+    pulse_measure_result_t result;
+
+    if (!pulse_measure_get(pin, &result) || result.is_stale)
+    {
+        return 0.0f;
+    }
+
+    return (float) clock_get_hz(clk_sys) / ((float) result.high_cycles + result.low_cycles);
+}
+
+float pulse_measure_duty_cycle(uint8_t pin)
+{
+    pulse_measure_result_t result;
+
+    if (!pulse_measure_get(pin, &result))
+    {
+        return 0.0f;
+    }
+
+    // A stopped signal is all high or all low.
+    if (result.is_stale)
+    {
+        return gpio_get(pin) ? 1.0f : 0.0f;
+    }
+
+    return (float) result.high_cycles / ((float) result.high_cycles + result.low_cycles);
+}
+
+#pragma endregion
@@ -0,0 +1,214 @@
+#include "PicoLibrary.h"
+#include "hardware/pwm.h"
+
+#pragma region PWM Waveform Functions
+
+typedef struct
+{
+    pwm_wave_segment_t segments[PWM_WAVE_MAX_SEGMENTS + 1]; // Ends with a null entry
+    int data_channel;
+    int control_channel;
+    bool is_looping;
+    bool is_active;
+    volatile bool is_running;
+} pwm_wave_t;
+
+pwm_wave_t pwm_waves[NUM_PWM_SLICES];
+uint8_t pwm_wave_active_count = 0;
+
+static void PICO_LIBRARY_HOT(pwm_wave_dma_handler)()
+{
+    for (uint slice = 0; slice < NUM_PWM_SLICES; slice++)
+    {
+        pwm_wave_t * wave = &pwm_waves[slice];
+
+        // The data channel is quiet, it only interrupts when the null entry at the end of the
+        // list is loaded into it.
+        if (!wave->is_active || !dma_channel_get_irq1_status(wave->data_channel))
+        {
+            continue;
+        }
+
+        dma_channel_acknowledge_irq1(wave->data_channel);
+
+        if (wave->is_looping)
+        {
+            dma_channel_set_read_addr(wave->control_channel, wave->segments, true);
+        }
+
+        else
+        {
+            wave->is_running = false;
+        }
+    }
+}
+
+int pwm_wave_start(uint8_t pin, uint16_t wrap, float step_hz, const pwm_wave_segment_t * segments, uint8_t segment_count, bool is_looping)
+{
+    if (pin >= NUM_BANK0_GPIOS || step_hz <= 0 || segment_count == 0 || segment_count > PWM_WAVE_MAX_SEGMENTS)
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    for (uint8_t i = 0; i < segment_count; i++)
+    {
+        if (segments[i].count == 0 || segments[i].levels == NULL)
+        {
+            return PICO_ERROR_INVALID_ARG;
+        }
+    }
+
+    // One step a PWM period, the divider is 8.4 fixed point from 1 to just under 256.
+    float divider = clock_get_hz(clk_sys) / (step_hz * (wrap + 1.0f));
+
+    if (divider < 1.0f || divider >= 256.0f)
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    uint slice = pwm_gpio_to_slice_num(pin);
+    pwm_wave_t * wave = &pwm_waves[slice];
+
+    if (wave->is_active)
+    {
+        pwm_wave_stop(pin);
+    }
+
+    int data_channel = dma_claim_unused_channel(false);
+    int control_channel = dma_claim_unused_channel(false);
+
+    if (data_channel < 0 || control_channel < 0)
+    {
+        if (data_channel >= 0)
+        {
+            dma_channel_unclaim(data_channel);
+        }
+
+        if (control_channel >= 0)
+        {
+            dma_channel_unclaim(control_channel);
+        }
+
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+
+    memcpy(wave->segments, segments, segment_count * sizeof(pwm_wave_segment_t));
+    wave->segments[segment_count] = (pwm_wave_segment_t) {0, NULL};
+    wave->data_channel = data_channel;
+    wave->control_channel = control_channel;
+    wave->is_looping = is_looping;
+
+    pwm_config pwm_cfg = pwm_get_default_config();
+    pwm_config_set_clkdiv(&pwm_cfg, divider);
+    pwm_config_set_wrap(&pwm_cfg, wrap);
+    pwm_init(slice, &pwm_cfg, false);
+    pwm_set_gpio_level(pin, segments[0].levels[0]);
+    gpio_set_function(pin, GPIO_FUNC_PWM);
+
+    // The compare register is double buffered, a level written during a period takes effect
+    // at the next wrap, so steps never glitch.
+    dma_channel_config cfg = dma_channel_get_default_config(data_channel);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, DREQ_PWM_WRAP0 + slice);
+    channel_config_set_chain_to(&cfg, control_channel);
+    channel_config_set_irq_quiet(&cfg, true);
+    dma_channel_configure(data_channel, &cfg, &pwm_hw->slice[slice].cc, NULL, 0, false);
+
+    // Each run writes one list entry to the data channel's count and read address, and the
+    // read address write starts it. The write ring brings it back to the count each time.
+    cfg = dma_channel_get_default_config(control_channel);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_32);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_ring(&cfg, true, 3);
+    dma_channel_configure(control_channel, &cfg, &dma_hw->ch[data_channel].al3_transfer_count, wave->segments, 2, false);
+
+    if (pwm_wave_active_count++ == 0)
+    {
+        irq_add_shared_handler(DMA_IRQ_1, pwm_wave_dma_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_1, true);
+    }
+
+    dma_channel_set_irq1_enabled(data_channel, true);
+    wave->is_active = true;
+    wave->is_running = true;
+
+    pwm_set_enabled(slice, true);
+    dma_channel_start(control_channel);
+    return PICO_OK;
+}
+
+void pwm_wave_stop(uint8_t pin)
+{
+    if (pin >= NUM_BANK0_GPIOS)
+    {
+        return;
+    }
+
+    uint slice = pwm_gpio_to_slice_num(pin);
+    pwm_wave_t * wave = &pwm_waves[slice];
+
+    if (!wave->is_active)
+    {
+        return;
+    }
+
+    // Unchain first so aborting the data channel does not start the control channel.
+    uint data_channel = wave->data_channel;
+    dma_channel_set_irq1_enabled(data_channel, false);
+    dma_channel_unchain(data_channel);
+
+    dma_channel_abort(wave->control_channel);
+    dma_channel_abort(data_channel);
+    dma_channel_acknowledge_irq1(data_channel);
+    dma_channel_unclaim(wave->control_channel);
+    dma_channel_unclaim(data_channel);
+
+    wave->is_active = false;
+    wave->is_running = false;
+    pwm_set_enabled(slice, false);
+
+    if (--pwm_wave_active_count == 0)
+    {
+        irq_remove_handler(DMA_IRQ_1, pwm_wave_dma_handler);
+    }
+}
+
+bool pwm_wave_is_running(uint8_t pin)
+{
+    return pin < NUM_BANK0_GPIOS && pwm_waves[pwm_gpio_to_slice_num(pin)].is_running;
+}
+
+// Squared raised cosine, closer to even steps of brightness than a plain sine.
+void pwm_wave_fill_breathe(uint16_t * levels, size_t count, uint16_t wrap)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        float level = (1 - cosf(2 * M_PI * i / count)) / 2;
+        levels[i] = lroundf(level * level * wrap);
+    }
+}
+
+void pwm_wave_fill_blink(uint16_t * levels, size_t count, uint16_t wrap, float duty)
+{
+    // wrap + 1 keeps the output high for the whole period.
+    uint16_t on = wrap < UINT16_MAX ? wrap + 1 : wrap;
+    size_t on_count = lroundf(duty * count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        levels[i] = i < on_count ? on : 0;
+    }
+}
+
+void pwm_wave_fill_sine(uint16_t * levels, size_t count, uint16_t wrap)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        levels[i] = lroundf((1 + sinf(2 * M_PI * i / count)) * wrap / 2);
+    }
+}
+
+#pragma endregion
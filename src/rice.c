@@ -0,0 +1,289 @@
+#include "rice.h"
+
+#pragma region Compression Functions
+
+typedef struct
+{
+    uint8_t * output;
+    uint32_t bits;
+    uint32_t count;
+} rice_writer_t;
+
+typedef struct
+{
+    const uint8_t * input;
+    const uint8_t * end;
+    uint32_t bits;
+    int32_t count;      // Negative once the reads run past the end
+} rice_reader_t;
+
+// Up to 25 bits at a time, whole bytes are written as soon as they fill.
+static inline void rice_put(rice_writer_t * writer, uint32_t value, uint32_t count)
+{
+    writer->bits |= value << writer->count;
+    writer->count += count;
+
+    while (writer->count >= 8)
+    {
+        *writer->output++ = writer->bits;
+        writer->bits >>= 8;
+        writer->count -= 8;
+    }
+}
+
+static inline uint32_t rice_get(rice_reader_t * reader, uint32_t count)
+{
+    uint32_t value = reader->bits & ((1u << count) - 1);
+    reader->bits >>= count;
+    reader->count -= count;
+    return value;
+}
+
+// Keeps at least 25 bits ready while there is input, past the end reads zeros.
+static inline void rice_fill(rice_reader_t * reader)
+{
+    while (reader->count <= 24 && reader->input < reader->end)
+    {
+        reader->bits |= (uint32_t) *reader->input++ << reader->count;
+        reader->count += 8;
+    }
+}
+
+// Zigzagged differences from the prediction a * previous - b * before + c, modulo 4096.
+static inline uint32_t rice_residuals(const uint16_t * samples, size_t count, const int32_t * coefficients, int32_t * previous, int32_t * before, uint16_t * residuals)
+{
+    int32_t a = coefficients[0];
+    int32_t b = coefficients[1];
+    int32_t c = coefficients[2];
+    int32_t p1 = *previous;
+    int32_t p2 = *before;
+    uint32_t sum = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        int32_t sample = samples[i] & 0xfff;
+        int32_t difference = (int32_t) ((uint32_t) (sample - (a * p1 - b * p2 + c)) << 20) >> 20;
+        uint32_t residual = ((uint32_t) difference << 1 ^ (uint32_t) (difference >> 31)) & 0xfff;
+
+        residuals[i] = residual;
+        sum += residual;
+        p2 = p1;
+        p1 = sample;
+    }
+
+    *previous = p1;
+    *before = p2;
+    return sum;
+}
+
+static inline void rice_write_partition(rice_writer_t * writer, const uint16_t * residuals, size_t count, uint32_t sum)
+{
+    // The usual estimate, the k that makes the mean about 2^k, then checked against raw.
+    uint32_t k = 0;
+
+    while (k < 11 && (count << (k + 1)) <= sum)
+    {
+        k++;
+    }
+
+    uint32_t bits = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t q = residuals[i] >> k;
+        bits += q < 12 ? q + 1 + k : 24;
+    }
+
+    if (bits >= count * 12)
+    {
+        rice_put(writer, RICE_ESCAPE, 4);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            rice_put(writer, residuals[i], 12);
+        }
+
+        return;
+    }
+
+    rice_put(writer, k, 4);
+    uint32_t mask = (1u << k) - 1;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t residual = residuals[i];
+        uint32_t q = residual >> k;
+
+        if (q < 12)
+        {
+            rice_put(writer, (1u << q) | ((residual & mask) << (q + 1)), q + 1 + k);
+        }
+
+        else
+        {
+            rice_put(writer, residual << 12, 24);
+        }
+    }
+}
+
+static const int32_t rice_predictors[3][3] =
+{
+    {0, 0, 2048},   // Mid-scale
+    {1, 0, 0},      // Last sample
+    {2, 1, 0}       // Line through the last two
+};
+
+size_t PICO_LIBRARY_HOT(rice_encode_block)(const uint16_t * samples, size_t count, uint8_t order, void * output)
+{
+    if (count == 0 || count > RICE_MAX_COUNT || order > 2)
+    {
+        return 0;
+    }
+
+    const int32_t * coefficients = rice_predictors[order];
+    size_t warmup = order < count ? order : count;
+    int32_t first[2] = {samples[0] & 0xfff, warmup > 1 ? samples[1] & 0xfff : 0};
+    int32_t previous = warmup > 1 ? first[1] : first[0];
+    int32_t before = first[0];
+    uint16_t residuals[RICE_PARTITION];
+    uint32_t sum = 0;
+
+    // Every partition is read before any of its output is written, and the output never
+    // overtakes the input, so the samples can be overwritten as they are encoded. That
+    // includes the first partition and the header.
+    size_t i = warmup;
+    size_t partition = count - i < RICE_PARTITION ? count - i : RICE_PARTITION;
+
+    if (partition > 0)
+    {
+        sum = rice_residuals(samples + i, partition, coefficients, &previous, &before, residuals);
+    }
+
+    uint8_t * header = output;
+    header[0] = count;
+    header[1] = count >> 8;
+    header[2] = order;
+    header[3] = 0;
+
+    rice_writer_t writer = {header + RICE_HEADER_SIZE, 0, 0};
+
+    for (size_t j = 0; j < warmup; j++)
+    {
+        rice_put(&writer, first[j], 12);
+    }
+
+    while (partition > 0)
+    {
+        rice_write_partition(&writer, residuals, partition, sum);
+        i += partition;
+        partition = count - i < RICE_PARTITION ? count - i : RICE_PARTITION;
+
+        if (partition > 0)
+        {
+            sum = rice_residuals(samples + i, partition, coefficients, &previous, &before, residuals);
+        }
+    }
+
+    if (writer.count > 0)
+    {
+        *writer.output++ = writer.bits;
+    }
+
+    return writer.output - header;
+}
+
+int rice_decode_block(const void * input, size_t length, uint16_t * samples, size_t max_count)
+{
+    const uint8_t * header = input;
+
+    if (length < RICE_HEADER_SIZE || header[2] > 2 || header[3] != 0)
+    {
+        return PICO_ERROR_INVALID_DATA;
+    }
+
+    size_t count = header[0] | (header[1] << 8);
+    uint8_t order = header[2];
+
+    if (count > max_count)
+    {
+        return PICO_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    const int32_t * coefficients = rice_predictors[order];
+    rice_reader_t reader = {header + RICE_HEADER_SIZE, header + length, 0, 0};
+    int32_t p1 = 0;
+    int32_t p2 = 0;
+    size_t i = 0;
+
+    for (; i < order && i < count; i++)
+    {
+        rice_fill(&reader);
+        p2 = p1;
+        p1 = rice_get(&reader, 12);
+        samples[i] = p1;
+    }
+
+    if (order == 1)
+    {
+        p2 = p1;
+    }
+
+    while (i < count)
+    {
+        rice_fill(&reader);
+        uint32_t k = rice_get(&reader, 4);
+        size_t end = count - i < RICE_PARTITION ? count : i + RICE_PARTITION;
+
+        if (k > 11 && k != RICE_ESCAPE)
+        {
+            return PICO_ERROR_INVALID_DATA;
+        }
+
+        for (; i < end; i++)
+        {
+            rice_fill(&reader);
+            uint32_t residual;
+
+            if (k == RICE_ESCAPE)
+            {
+                residual = rice_get(&reader, 12);
+            }
+
+            else if ((reader.bits & 0xfff) == 0)
+            {
+                rice_get(&reader, 12);
+                rice_fill(&reader);
+                residual = rice_get(&reader, 12);
+            }
+
+            else
+            {
+                uint32_t q = 0;
+
+                while (!(reader.bits & (1u << q)))
+                {
+                    q++;
+                }
+
+                rice_get(&reader, q + 1);
+                residual = (q << k) | rice_get(&reader, k);
+            }
+
+            int32_t difference = (int32_t) (residual >> 1) ^ -(int32_t) (residual & 1);
+            int32_t sample = (coefficients[0] * p1 - coefficients[1] * p2 + coefficients[2] + difference) & 0xfff;
+
+            samples[i] = sample;
+            p2 = p1;
+            p1 = sample;
+        }
+
+        if (reader.count < 0)
+        {
+            return PICO_ERROR_INVALID_DATA;
+        }
+    }
+
+    return count;
+}
+
+#pragma endregion
@@ -0,0 +1,29 @@
+#ifndef PICO_LIBRARY_RICE_H_
+#define PICO_LIBRARY_RICE_H_
+
+#include "portable.h"
+
+// Compression functions
+// Lossless blocks of 12-bit samples. Each sample is predicted from the ones before it, by
+// mid-scale, the last sample, or extending the line through the last two, and the
+// difference modulo 4096 is Rice coded with a k chosen for every RICE_PARTITION samples.
+// A partition that would not save anything is stored as raw 12-bit values instead, so a
+// block is never bigger than packed samples plus half a byte a partition. Blocks start with
+// the sample count (2 bytes, little-endian), the predictor order and a zero byte, then the
+// first order samples as 12 bits each and the partitions. Each partition is a 4-bit k and
+// the codes, k == RICE_ESCAPE for raw values. A code is q zeros and a one, then the low k
+// bits of the zigzagged difference, 2d or -2d - 1, with q = that >> k. Twelve zeros escape
+// to the 12-bit value. Bits are little-endian and least significant first, as in
+// pack12_block. Encoding may be done in place. Blocks can go to uart_dma_write or
+// flash_log_append as they are, and decode with plain C, on the Pico or a host, as
+// host/rice_decode.c does. Bytes after the end of a block are ignored, so it may be padded.
+#define RICE_PARTITION 32
+#define RICE_ESCAPE 15
+#define RICE_HEADER_SIZE 4
+#define RICE_MAX_COUNT UINT16_MAX
+#define RICE_MAX_BYTES(count) (RICE_HEADER_SIZE + ((count) * 12 + ((count) / RICE_PARTITION + 1) * 4 + 7) / 8)
+
+size_t PICO_LIBRARY_HOT(rice_encode_block)(const uint16_t * samples, size_t count, uint8_t order, void * output);
+int rice_decode_block(const void * input, size_t length, uint16_t * samples, size_t max_count);
+
+#endif
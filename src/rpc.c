@@ -0,0 +1,166 @@
+#include "rpc.h"
+
+#pragma region RPC Functions
+
+uint8_t rpc_rx_buffer[RPC_HEADER_SIZE + RPC_MAX_PAYLOAD];
+size_t rpc_rx_count = 0;
+size_t rpc_rx_skip = 0;
+uint8_t rpc_tx_buffer[RPC_TX_BUFFER_SIZE];
+size_t rpc_tx_count = 0;
+void (*rpc_write)(const uint8_t * data, size_t count) = NULL;
+rpc_handler_t rpc_handler = NULL;
+rpc_stats_t rpc_stats;
+
+static void rpc_dispatch(uint8_t command, uint8_t sequence, const uint8_t * payload, uint16_t length)
+{
+    // Replies are batched, only go out early when the next one might not fit.
+    if (rpc_tx_count + RPC_HEADER_SIZE + RPC_MAX_PAYLOAD > RPC_TX_BUFFER_SIZE)
+    {
+        rpc_flush();
+    }
+
+    uint8_t * reply = rpc_tx_buffer + rpc_tx_count;
+    int result;
+
+    if (length > RPC_MAX_PAYLOAD)
+    {
+        result = PICO_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    else if (command == RPC_PING)
+    {
+        memcpy(reply + RPC_HEADER_SIZE, payload, length);
+        result = length;
+    }
+
+    else
+    {
+        result = rpc_handler != NULL ? rpc_handler(command, payload, length, reply + RPC_HEADER_SIZE) : PICO_ERROR_INVALID_ARG;
+    }
+
+    uint16_t reply_length = result > 0 ? result : 0;
+
+    if (result < 0)
+    {
+        rpc_stats.errors++;
+    }
+
+    reply[0] = RPC_REPLY_SYNC;
+    reply[1] = result < 0 ? result : PICO_OK;
+    reply[2] = sequence;
+    rpc_put_uint16(reply + 3, reply_length);
+
+    rpc_tx_count += RPC_HEADER_SIZE + reply_length;
+    rpc_stats.frames++;
+}
+
+void rpc_init_with_handler(void (*write)(const uint8_t * data, size_t count), rpc_handler_t handler)
+{
+    rpc_write = write;
+    rpc_handler = handler;
+    rpc_rx_count = 0;
+    rpc_rx_skip = 0;
+    rpc_tx_count = 0;
+    memset(&rpc_stats, 0, sizeof(rpc_stats));
+}
+
+size_t rpc_receive(const uint8_t * data, size_t count)
+{
+    size_t frames = 0;
+
+    while (count > 0)
+    {
+        // Payload of a frame that was too long to buffer.
+        if (rpc_rx_skip > 0)
+        {
+            size_t skip = rpc_rx_skip < count ? rpc_rx_skip : count;
+            rpc_rx_skip -= skip;
+            rpc_stats.discarded_bytes += skip;
+            data += skip;
+            count -= skip;
+            continue;
+        }
+
+        // Between frames, skip anything up to the next sync byte.
+        if (rpc_rx_count == 0)
+        {
+            const uint8_t * sync = memchr(data, RPC_REQUEST_SYNC, count);
+
+            if (sync == NULL)
+            {
+                rpc_stats.discarded_bytes += count;
+                break;
+            }
+
+            rpc_stats.discarded_bytes += sync - data;
+            count -= sync - data;
+            data = sync;
+        }
+
+        size_t frame_size = RPC_HEADER_SIZE;
+
+        if (rpc_rx_count >= RPC_HEADER_SIZE)
+        {
+            frame_size += rpc_get_uint16(rpc_rx_buffer + 3);
+        }
+
+        size_t needed = frame_size - rpc_rx_count;
+        size_t copy = needed < count ? needed : count;
+        memcpy(rpc_rx_buffer + rpc_rx_count, data, copy);
+        rpc_rx_count += copy;
+        data += copy;
+        count -= copy;
+
+        if (rpc_rx_count == RPC_HEADER_SIZE)
+        {
+            uint16_t length = rpc_get_uint16(rpc_rx_buffer + 3);
+
+            if (length > RPC_MAX_PAYLOAD)
+            {
+                // Too long to buffer, answer with an error and drop the payload.
+                rpc_dispatch(rpc_rx_buffer[1], rpc_rx_buffer[2], NULL, length);
+                rpc_rx_count = 0;
+                rpc_rx_skip = length;
+                frames++;
+                continue;
+            }
+
+            frame_size += length;
+        }
+
+        if (rpc_rx_count == frame_size)
+        {
+            rpc_dispatch(rpc_rx_buffer[1], rpc_rx_buffer[2], rpc_rx_buffer + RPC_HEADER_SIZE, frame_size - RPC_HEADER_SIZE);
+            rpc_rx_count = 0;
+            frames++;
+        }
+    }
+
+    return frames;
+}
+
+int rpc_flush()
+{
+    int written = rpc_tx_count;
+
+    if (rpc_tx_count > 0)
+    {
+        rpc_write(rpc_tx_buffer, rpc_tx_count);
+        rpc_tx_count = 0;
+        rpc_stats.batches++;
+    }
+
+    return written;
+}
+
+size_t rpc_pending()
+{
+    return rpc_tx_count;
+}
+
+void rpc_get_stats(rpc_stats_t * stats)
+{
+    *stats = rpc_stats;
+}
+
+#pragma endregion
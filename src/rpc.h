@@ -0,0 +1,78 @@
+#ifndef PICO_LIBRARY_RPC_H_
+#define PICO_LIBRARY_RPC_H_
+
+#include "portable.h"
+
+// RPC functions
+// Framed binary commands. Requests can be pipelined, replies are batched and written once
+// the host stops sending or the batch buffer fills. All fields are little-endian:
+//     request: RPC_REQUEST_SYNC, command, sequence, length (2 bytes), payload
+//     reply:   RPC_REPLY_SYNC, status, sequence, length (2 bytes), payload
+// The sequence is copied from the request and status is PICO_OK or a PICO_ERROR_* code.
+// The reply sync byte never appears in ASCII console output, so a host can skip text.
+// rpc_receive takes bytes from any source and replies go to the write function, so the
+// protocol also runs over a pipe or a pty. RPC_PING is answered here, every other command
+// goes to the handler, which returns the reply length or a PICO_ERROR_* code.
+#define RPC_REQUEST_SYNC 0xa5
+#define RPC_REPLY_SYNC 0xa6
+#define RPC_HEADER_SIZE 5
+#define RPC_MAX_PAYLOAD 1024
+#define RPC_TX_BUFFER_SIZE 4096
+
+enum rpc_command_enum
+{
+    RPC_PING = 0x00,                // Payload is echoed back
+    RPC_EXIT = 0x01,                // Returns from rpc_serve
+    RPC_ADC_SELECT = 0x10,          // uint8 input
+    RPC_ADC_READ = 0x11,            // Reply is the uint16 raw reading
+    RPC_ADC_READ_BULK = 0x12,       // uint16 count, reply is count uint16 readings
+    RPC_GPIO_INIT_MASK = 0x20,      // uint32 pin mask
+    RPC_GPIO_SET_DIR_MASK = 0x21,   // uint32 pin mask, uint32 outputs
+    RPC_GPIO_PUT_MASK = 0x22,       // uint32 pin mask, uint32 levels
+    RPC_GPIO_GET_ALL = 0x23,        // Reply is the uint32 pin levels
+    RPC_PWM_SET = 0x30,             // uint8 pin, uint16 wrap, uint16 level
+    RPC_CLOCK_GET_HZ = 0x40         // uint8 clock index, reply is the uint32 frequency
+};
+
+typedef int (*rpc_handler_t)(uint8_t command, const uint8_t * payload, uint16_t length, uint8_t * reply);
+
+typedef struct
+{
+    uint32_t frames;
+    uint32_t errors;
+    uint32_t batches;
+    uint32_t discarded_bytes;
+} rpc_stats_t;
+
+void rpc_init_with_handler(void (*write)(const uint8_t * data, size_t count), rpc_handler_t handler);
+size_t rpc_receive(const uint8_t * data, size_t count);
+int rpc_flush();
+size_t rpc_pending();
+void rpc_get_stats(rpc_stats_t * stats);
+
+// Little-endian payload fields, byte by byte since Cortex-M0+ faults on unaligned access.
+static inline uint16_t rpc_get_uint16(const uint8_t * data)
+{
+    return data[0] | (data[1] << 8);
+}
+
+static inline uint32_t rpc_get_uint32(const uint8_t * data)
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static inline void rpc_put_uint16(uint8_t * data, uint16_t value)
+{
+    data[0] = value;
+    data[1] = value >> 8;
+}
+
+static inline void rpc_put_uint32(uint8_t * data, uint32_t value)
+{
+    data[0] = value;
+    data[1] = value >> 8;
+    data[2] = value >> 16;
+    data[3] = value >> 24;
+}
+
+#endif
@@ -0,0 +1,192 @@
+#include "PicoLibrary.h"
+#include "hardware/pwm.h"
+
+#pragma region RPC Command Functions
+
+_Static_assert(RPC_MAX_PAYLOAD <= SAMPLE_POOL_BLOCK_SIZE, "A bulk read must fit in a sample pool block");
+
+bool is_rpc_init = false;
+bool is_rpc_running = false;
+
+static void rpc_stdio_write(const uint8_t * data, size_t count)
+{
+    // No CR/LF translation, the replies are binary.
+    stdio_put_string((const char *)data, count, false, false);
+    stdio_flush();
+}
+
+// Runs one command for rpc_receive, writing its reply payload to reply. Returns the payload
+// length or a PICO_ERROR_* code.
+static int rpc_handle(uint8_t command, const uint8_t * payload, uint16_t length, uint8_t * reply)
+{
+    switch (command)
+    {
+        case RPC_EXIT:
+        {
+            is_rpc_running = false;
+            return 0;
+        }
+
+        case RPC_ADC_SELECT:
+        {
+            if (length != 1 || payload[0] > 4)
+            {
+                return PICO_ERROR_INVALID_ARG;
+            }
+
+            adc_input_init(payload[0]);
+            adc_select_pin(payload[0]);
+            return 0;
+        }
+
+        case RPC_ADC_READ:
+        {
+            rpc_put_uint16(reply, adc_read_selected_raw());
+            return 2;
+        }
+
+        case RPC_ADC_READ_BULK:
+        {
+            if (length != 2)
+            {
+                return PICO_ERROR_INVALID_ARG;
+            }
+
+            uint16_t count = rpc_get_uint16(payload);
+
+            if (count > RPC_MAX_PAYLOAD / 2)
+            {
+                return PICO_ERROR_BUFFER_TOO_SMALL;
+            }
+
+            // The reply after the header is unaligned, so the samples go through a pool block.
+            block_pool_t * pool = sample_pool_get();
+            uint16_t * samples = pool != NULL ? block_pool_alloc(pool) : NULL;
+
+            if (samples == NULL)
+            {
+                return PICO_ERROR_INSUFFICIENT_RESOURCES;
+            }
+
+            adc_capture(samples, count);
+
+            for (uint16_t i = 0; i < count; i++)
+            {
+                rpc_put_uint16(reply + i * 2, samples[i]);
+            }
+
+            block_pool_release(pool, samples);
+            return count * 2;
+        }
+
+        case RPC_GPIO_INIT_MASK:
+        {
+            if (length != 4)
+            {
+                return PICO_ERROR_INVALID_ARG;
+            }
+
+            gpio_init_mask(rpc_get_uint32(payload));
+            is_gpio_init = true;
+            return 0;
+        }
+
+        case RPC_GPIO_SET_DIR_MASK:
+        {
+            if (length != 8)
+            {
+                return PICO_ERROR_INVALID_ARG;
+            }
+
+            gpio_set_dir_masked(rpc_get_uint32(payload), rpc_get_uint32(payload + 4));
+            return 0;
+        }
+
+        case RPC_GPIO_PUT_MASK:
+        {
+            if (length != 8)
+            {
+                return PICO_ERROR_INVALID_ARG;
+            }
+
+            gpio_put_masked(rpc_get_uint32(payload), rpc_get_uint32(payload + 4));
+            return 0;
+        }
+
+        case RPC_GPIO_GET_ALL:
+        {
+            rpc_put_uint32(reply, gpio_get_all());
+            return 4;
+        }
+
+        case RPC_PWM_SET:
+        {
+            if (length != 5 || payload[0] >= NUM_BANK0_GPIOS)
+            {
+                return PICO_ERROR_INVALID_ARG;
+            }
+
+            uint8_t pin = payload[0];
+            uint slice = pwm_gpio_to_slice_num(pin);
+            pwm_set_wrap(slice, rpc_get_uint16(payload + 1));
+            pwm_set_gpio_level(pin, rpc_get_uint16(payload + 3));
+            gpio_set_function(pin, GPIO_FUNC_PWM);
+            pwm_set_enabled(slice, true);
+            return 0;
+        }
+
+        case RPC_CLOCK_GET_HZ:
+        {
+            if (length != 1 || payload[0] >= CLK_COUNT)
+            {
+                return PICO_ERROR_INVALID_ARG;
+            }
+
+            rpc_put_uint32(reply, clock_get_hz(payload[0]));
+            return 4;
+        }
+
+        default:
+            return PICO_ERROR_INVALID_ARG;
+    }
+}
+
+void rpc_init(void (*write)(const uint8_t * data, size_t count))
+{
+    rpc_init_with_handler(write != NULL ? write : rpc_stdio_write, rpc_handle);
+    is_rpc_init = true;
+}
+
+void rpc_serve()
+{
+    static uint8_t chunk[256];
+
+    if (!is_rpc_init)
+    {
+        rpc_init(NULL);
+    }
+
+    is_rpc_running = true;
+
+    while (is_rpc_running)
+    {
+        // Block while there is nothing to answer, otherwise just poll so the batch goes out
+        // as soon as the host stops sending.
+        absolute_time_t until = rpc_pending() > 0 ? get_absolute_time() : at_the_end_of_time;
+        int count = stdio_get_until((char *)chunk, sizeof(chunk), until);
+
+        if (count > 0)
+        {
+            rpc_receive(chunk, count);
+        }
+
+        else
+        {
+            rpc_flush();
+        }
+    }
+
+    rpc_flush();
+}
+
+#pragma endregion
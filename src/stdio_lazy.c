@@ -0,0 +1,112 @@
+#include "PicoLibrary.h"
+#include "pico/stdio/driver.h"
+
+#pragma region Lazy Stdio Functions
+
+// Weak so the library links whether or not the image has USB or UART stdio.
+extern stdio_driver_t stdio_usb __attribute__((weak));
+bool stdio_usb_connected() __attribute__((weak));
+
+char stdio_lazy_buffer[STDIO_LAZY_BUFFER_SIZE];
+uint32_t stdio_lazy_count = 0;
+uint32_t stdio_lazy_dropped_bytes = 0;
+
+// Called with the stdio mutex held, like any stdio driver.
+static void stdio_lazy_drain()
+{
+    if (stdio_lazy_count > 0)
+    {
+        stdio_usb.out_chars(stdio_lazy_buffer, stdio_lazy_count);
+        stdio_lazy_count = 0;
+    }
+}
+
+static void stdio_lazy_out_chars(const char * buf, int length)
+{
+    if (stdio_usb_connected())
+    {
+        stdio_lazy_drain();
+        stdio_usb.out_chars(buf, length);
+        return;
+    }
+
+    // Keep the oldest output, that is where the boot messages are.
+    uint32_t space = STDIO_LAZY_BUFFER_SIZE - stdio_lazy_count;
+    uint32_t count = (uint32_t) length < space ? (uint32_t) length : space;
+
+    memcpy(stdio_lazy_buffer + stdio_lazy_count, buf, count);
+    stdio_lazy_count += count;
+    stdio_lazy_dropped_bytes += length - count;
+}
+
+static void stdio_lazy_out_flush()
+{
+    if (stdio_usb_connected())
+    {
+        stdio_lazy_drain();
+
+        if (stdio_usb.out_flush != NULL)
+        {
+            stdio_usb.out_flush();
+        }
+    }
+}
+
+static int stdio_lazy_in_chars(char * buf, int length)
+{
+    return stdio_usb.in_chars(buf, length);
+}
+
+static void stdio_lazy_set_chars_available_callback(void (*callback)(void *), void * param)
+{
+    if (stdio_usb.set_chars_available_callback != NULL)
+    {
+        stdio_usb.set_chars_available_callback(callback, param);
+    }
+}
+
+// Stands in for stdio_usb in the driver list, output is translated to CR/LF before
+// it gets here so the USB driver is called directly.
+stdio_driver_t stdio_lazy_driver =
+{
+    .out_chars = stdio_lazy_out_chars,
+    .out_flush = stdio_lazy_out_flush,
+    .in_chars = stdio_lazy_in_chars,
+    .set_chars_available_callback = stdio_lazy_set_chars_available_callback,
+    #if PICO_STDIO_ENABLE_CRLF_SUPPORT
+        .crlf_enabled = PICO_STDIO_DEFAULT_CRLF
+    #endif
+};
+
+void stdio_lazy_init()
+{
+    // With the SDK default PICO_STDIO_USB_CONNECT_WAIT_TIMEOUT_MS of 0 this only starts
+    // TinyUSB, enumeration carries on in the background.
+    stdio_init_all();
+
+    if (&stdio_usb != NULL && stdio_usb_connected != NULL)
+    {
+        stdio_set_driver_enabled(&stdio_usb, false);
+        stdio_set_driver_enabled(&stdio_lazy_driver, true);
+    }
+
+    boot_mark("stdio init");
+}
+
+bool stdio_lazy_is_connected()
+{
+    return stdio_usb_connected != NULL && stdio_usb_connected();
+}
+
+void stdio_lazy_flush()
+{
+    // Goes through stdio for its mutex, which ends up in stdio_lazy_out_flush.
+    stdio_flush();
+}
+
+uint32_t stdio_lazy_dropped()
+{
+    return stdio_lazy_dropped_bytes;
+}
+
+#pragma endregion
@@ -0,0 +1,137 @@
+#include <math.h>
+#include "telemetry.h"
+
+#pragma region Telemetry Functions
+
+uint8_t telemetry_packet[TELEMETRY_PACKET_SIZE];
+uint8_t telemetry_record_count = 0;
+uint32_t telemetry_sequence = 0;
+uint32_t telemetry_packet_ms = 0; // Time of the packet's first record
+uint32_t telemetry_flush_ms = 0;
+bool (*telemetry_send)(const uint8_t * data, size_t length) = NULL;
+telemetry_stats_t telemetry_stats;
+uint64_t telemetry_start_time;
+
+// Byte by byte, records are not aligned.
+static inline void telemetry_put_uint16(uint8_t * data, uint16_t value)
+{
+    data[0] = value;
+    data[1] = value >> 8;
+}
+
+static inline void telemetry_put_uint32(uint8_t * data, uint32_t value)
+{
+    data[0] = value;
+    data[1] = value >> 8;
+    data[2] = value >> 16;
+    data[3] = value >> 24;
+}
+
+static inline uint32_t telemetry_now_ms()
+{
+    return time_us_64() / 1000;
+}
+
+void telemetry_init(bool (*send)(const uint8_t * data, size_t length), uint32_t flush_ms)
+{
+    telemetry_send = send;
+    telemetry_flush_ms = flush_ms;
+    telemetry_record_count = 0;
+    telemetry_sequence = 0;
+    telemetry_stats = (telemetry_stats_t) {0};
+    telemetry_start_time = time_us_64();
+}
+
+int telemetry_flush()
+{
+    if (telemetry_record_count == 0)
+    {
+        return 0;
+    }
+
+    size_t length = TELEMETRY_HEADER_SIZE + telemetry_record_count * TELEMETRY_RECORD_SIZE;
+    telemetry_put_uint16(telemetry_packet, TELEMETRY_MAGIC);
+    telemetry_packet[2] = TELEMETRY_VERSION;
+    telemetry_packet[3] = telemetry_record_count;
+    telemetry_put_uint32(telemetry_packet + 4, telemetry_sequence);
+    telemetry_put_uint32(telemetry_packet + 8, telemetry_packet_ms);
+
+    // The sequence moves on for dropped packets too, so the receiver sees the gap.
+    telemetry_sequence++;
+    telemetry_record_count = 0;
+
+    if (telemetry_send == NULL || !telemetry_send(telemetry_packet, length))
+    {
+        telemetry_stats.packets_dropped++;
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+
+    telemetry_stats.packets_sent++;
+    telemetry_stats.bytes_sent += length;
+    return length;
+}
+
+void telemetry_add(enum telemetry_record_enum type, uint8_t channel, uint16_t value)
+{
+    uint32_t now_ms = telemetry_now_ms();
+
+    // Record times are 16-bit offsets from the header time.
+    if (telemetry_record_count > 0 && now_ms - telemetry_packet_ms > UINT16_MAX)
+    {
+        telemetry_flush();
+    }
+
+    if (telemetry_record_count == 0)
+    {
+        telemetry_packet_ms = now_ms;
+    }
+
+    uint8_t * record = telemetry_packet + TELEMETRY_HEADER_SIZE + telemetry_record_count * TELEMETRY_RECORD_SIZE;
+    record[0] = type;
+    record[1] = channel;
+    telemetry_put_uint16(record + 2, now_ms - telemetry_packet_ms);
+    telemetry_put_uint16(record + 4, value);
+
+    telemetry_record_count++;
+    telemetry_stats.records++;
+
+    if (telemetry_record_count == TELEMETRY_MAX_RECORDS)
+    {
+        telemetry_flush();
+    }
+}
+
+void telemetry_add_adc(uint8_t adc_input, uint16_t raw)
+{
+    telemetry_add(TELEMETRY_ADC, adc_input, raw);
+}
+
+void telemetry_add_vsys(bool is_battery_powered, float volts)
+{
+    int32_t millivolts = volts * 1000 + 0.5f;
+    telemetry_add(TELEMETRY_VSYS, is_battery_powered, millivolts < 0 ? 0 : millivolts > UINT16_MAX ? UINT16_MAX : millivolts);
+}
+
+void telemetry_add_temperature(float celsius)
+{
+    int32_t hundredths = lroundf(celsius * 100);
+    telemetry_add(TELEMETRY_TEMPERATURE, 0, (int16_t) (hundredths < INT16_MIN ? INT16_MIN : hundredths > INT16_MAX ? INT16_MAX : hundredths));
+}
+
+void telemetry_poll()
+{
+    if (telemetry_record_count > 0 && telemetry_flush_ms > 0 && telemetry_now_ms() - telemetry_packet_ms >= telemetry_flush_ms)
+    {
+        telemetry_flush();
+    }
+}
+
+void telemetry_get_stats(telemetry_stats_t * stats)
+{
+    *stats = telemetry_stats;
+
+    uint64_t elapsed = time_us_64() - telemetry_start_time;
+    stats->packets_per_second = elapsed > 0 ? stats->packets_sent * 1000000.0f / elapsed : 0.0f;
+}
+
+#pragma endregion
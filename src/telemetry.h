@@ -0,0 +1,47 @@
+#ifndef PICO_LIBRARY_TELEMETRY_H_
+#define PICO_LIBRARY_TELEMETRY_H_
+
+#include "portable.h"
+
+// Telemetry functions
+// Readings are batched into binary packets sized for one UDP datagram on a 1500 byte MTU.
+// A packet is a 12-byte header (uint16 TELEMETRY_MAGIC, uint8 version, uint8 record count,
+// uint32 sequence, uint32 time in ms of the first record) followed by 6-byte records (uint8
+// type, uint8 channel, uint16 ms after the header time, 16-bit value), all little endian.
+// A packet goes out when it is full, when telemetry_poll finds it older than flush_ms or
+// when the next record is too far from the header time. The packet code only needs a
+// send function that returns false when the packet was dropped, so it also runs on a host.
+#define TELEMETRY_MAGIC 0x4c50 // "PL"
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_PACKET_SIZE 1472 // 1500 byte MTU - 20 byte IP header - 8 byte UDP header
+#define TELEMETRY_HEADER_SIZE 12
+#define TELEMETRY_RECORD_SIZE 6
+#define TELEMETRY_MAX_RECORDS ((TELEMETRY_PACKET_SIZE - TELEMETRY_HEADER_SIZE) / TELEMETRY_RECORD_SIZE)
+#define TELEMETRY_DEFAULT_PORT 4950
+
+enum telemetry_record_enum
+{
+    TELEMETRY_ADC = 1,          // Channel is the ADC input, value the raw 12-bit reading
+    TELEMETRY_VSYS = 2,         // Channel is 1 on battery, value in mV
+    TELEMETRY_TEMPERATURE = 3   // Value in hundredths of a degree C, signed
+};
+
+typedef struct
+{
+    uint32_t packets_sent;
+    uint32_t packets_dropped;
+    uint32_t records;
+    uint32_t bytes_sent;
+    float packets_per_second;
+} telemetry_stats_t;
+
+void telemetry_init(bool (*send)(const uint8_t * data, size_t length), uint32_t flush_ms);
+void telemetry_add(enum telemetry_record_enum type, uint8_t channel, uint16_t value);
+void telemetry_add_adc(uint8_t adc_input, uint16_t raw);
+void telemetry_add_vsys(bool is_battery_powered, float volts);
+void telemetry_add_temperature(float celsius);
+int telemetry_flush();
+void telemetry_poll();
+void telemetry_get_stats(telemetry_stats_t * stats);
+
+#endif
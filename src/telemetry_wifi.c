@@ -0,0 +1,99 @@
+#include "PicoLibrary.h"
+#include "pico/cyw43_arch.h"
+#include "lwip/pbuf.h"
+#include "lwip/udp.h"
+
+#pragma region Telemetry WiFi Functions
+
+struct udp_pcb * telemetry_pcb = NULL;
+ip_addr_t telemetry_address;
+uint16_t telemetry_port = 0;
+
+static bool telemetry_udp_send(const uint8_t * data, size_t length)
+{
+    err_t result = ERR_MEM;
+
+    // lwIP runs from the cyw43 interrupt, this keeps it out while the packet is queued.
+    cyw43_arch_lwip_begin();
+    struct pbuf * buffer = pbuf_alloc(PBUF_TRANSPORT, length, PBUF_RAM);
+
+    if (buffer != NULL)
+    {
+        memcpy(buffer->payload, data, length);
+        result = udp_sendto(telemetry_pcb, buffer, &telemetry_address, telemetry_port);
+        pbuf_free(buffer);
+    }
+
+    cyw43_arch_lwip_end();
+    return result == ERR_OK;
+}
+
+int telemetry_wifi_connect(const char * ssid, const char * password, uint32_t timeout_ms)
+{
+    if (!is_pico_w_init)
+    {
+        if (cyw43_arch_init() != 0)
+        {
+            return PICO_ERROR_GENERIC;
+        }
+
+        is_pico_w_init = true;
+    }
+
+    cyw43_arch_enable_sta_mode();
+
+    if (cyw43_arch_wifi_connect_timeout_ms(ssid, password, CYW43_AUTH_WPA2_AES_PSK, timeout_ms) != 0)
+    {
+        return PICO_ERROR_CONNECT_FAILED;
+    }
+
+    return PICO_OK;
+}
+
+int telemetry_udp_open(const char * host, uint16_t port, uint32_t flush_ms)
+{
+    if (!ipaddr_aton(host, &telemetry_address) || port == 0)
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    if (telemetry_pcb == NULL)
+    {
+        cyw43_arch_lwip_begin();
+        telemetry_pcb = udp_new_ip_type(IPADDR_TYPE_ANY);
+        cyw43_arch_lwip_end();
+
+        if (telemetry_pcb == NULL)
+        {
+            return PICO_ERROR_INSUFFICIENT_RESOURCES;
+        }
+    }
+
+    telemetry_port = port;
+    telemetry_init(telemetry_udp_send, flush_ms);
+    return PICO_OK;
+}
+
+void telemetry_add_readings(uint8_t adc_input_mask)
+{
+    // GPIO 26 to 28, input 3 is VSYS on Pico W and read below.
+    for (uint8_t adc_input = 0; adc_input < 3; adc_input++)
+    {
+        if (adc_input_mask & (1 << adc_input))
+        {
+            telemetry_add_adc(adc_input, adc_read_gpio_pin_raw(adc_input));
+        }
+    }
+
+    bool is_battery_powered;
+    float volts;
+
+    if (power_get_status(&is_battery_powered) == PICO_OK && power_get_voltage_status(&volts, 26, 3) == PICO_OK)
+    {
+        telemetry_add_vsys(is_battery_powered, volts);
+    }
+
+    telemetry_add_temperature(acd_read_onboard_temperature(CELCIUS, 4));
+}
+
+#pragma endregion
@@ -0,0 +1,38 @@
+#include "PicoLibrary.h"
+
+#pragma region Timing Functions
+
+// SysTick counts clk_sys cycles down from its 24-bit reload value. It is per core,
+// so start it on the core being measured and keep spans under 2^24 cycles.
+void cycle_counter_start()
+{
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;
+}
+
+uint32_t PICO_LIBRARY_HOT(cycle_counter_get)()
+{
+    return systick_hw->cvr;
+}
+
+uint32_t PICO_LIBRARY_HOT(cycle_counter_elapsed)(uint32_t start)
+{
+    return (start - systick_hw->cvr) & 0x00FFFFFF;
+}
+
+// The XIP cache counts every flash access and every hit until cleared, so a miss count is
+// accesses - hits. Code running from SRAM or scratch does not touch either counter.
+void xip_cache_stats_reset()
+{
+    xip_ctrl_hw->ctr_hit = 0;
+    xip_ctrl_hw->ctr_acc = 0;
+}
+
+void xip_cache_stats_get(xip_cache_stats_t * stats)
+{
+    stats->hits = xip_ctrl_hw->ctr_hit;
+    stats->accesses = xip_ctrl_hw->ctr_acc;
+}
+
+#pragma endregion
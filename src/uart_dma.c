@@ -0,0 +1,252 @@
+#include "PicoLibrary.h"
+
+#pragma region UART DMA Functions
+
+uint8_t uart_dma_rx_ring[UART_DMA_RX_SIZE] __aligned(UART_DMA_RX_SIZE);
+uint8_t uart_dma_tx_ring[UART_DMA_TX_SIZE];
+uart_inst_t * uart_dma_uart = NULL;
+int uart_dma_tx_channel = -1;
+int uart_dma_rx_channel = -1;
+
+// Free running byte counts, taken modulo the ring size to index the rings.
+volatile uint32_t uart_dma_tx_head = 0;
+volatile uint32_t uart_dma_tx_tail = 0;
+volatile uint32_t uart_dma_tx_sending = 0;
+volatile uint32_t uart_dma_rx_base = 0;
+uint32_t uart_dma_rx_tail = 0;
+uint32_t uart_dma_rx_last_head = 0;
+bool is_uart_dma_rx_active = false;
+
+void (*uart_dma_idle_callback)(size_t available) = NULL;
+repeating_timer_t uart_dma_idle_timer;
+uart_dma_stats_t uart_dma_stats;
+
+static inline uint32_t uart_dma_rx_head()
+{
+    // The RX channel counts down from UINT32_MAX.
+    return uart_dma_rx_base + (UINT32_MAX - dma_channel_hw_addr(uart_dma_rx_channel)->transfer_count);
+}
+
+// Call with interrupts disabled.
+static void PICO_LIBRARY_HOT(uart_dma_tx_start)()
+{
+    uint32_t count = uart_dma_tx_head - uart_dma_tx_tail;
+
+    if (uart_dma_tx_sending > 0 || count == 0)
+    {
+        return;
+    }
+
+    // One transfer per contiguous run, the wrapped part goes next.
+    uint32_t index = uart_dma_tx_tail % UART_DMA_TX_SIZE;
+
+    if (count > UART_DMA_TX_SIZE - index)
+    {
+        count = UART_DMA_TX_SIZE - index;
+    }
+
+    uart_dma_tx_sending = count;
+    dma_channel_transfer_from_buffer_now(uart_dma_tx_channel, uart_dma_tx_ring + index, count);
+}
+
+static void PICO_LIBRARY_HOT(uart_dma_tx_handler)()
+{
+    if (!dma_channel_get_irq1_status(uart_dma_tx_channel))
+    {
+        return;
+    }
+
+    dma_channel_acknowledge_irq1(uart_dma_tx_channel);
+
+    uart_dma_tx_tail += uart_dma_tx_sending;
+    uart_dma_stats.tx_bytes += uart_dma_tx_sending;
+    uart_dma_tx_sending = 0;
+    uart_dma_tx_start();
+}
+
+static bool PICO_LIBRARY_HOT(uart_dma_idle_timer_callback)(repeating_timer_t * timer)
+{
+    // Carry on once the 4G byte transfer count runs out, from the same ring position.
+    if (!dma_channel_is_busy(uart_dma_rx_channel))
+    {
+        uart_dma_rx_base += UINT32_MAX;
+        dma_channel_set_trans_count(uart_dma_rx_channel, UINT32_MAX, true);
+    }
+
+    uint32_t head = uart_dma_rx_head();
+
+    if (head != uart_dma_rx_last_head)
+    {
+        uart_dma_rx_last_head = head;
+        is_uart_dma_rx_active = true;
+    }
+
+    // Nothing new for a whole period after receiving something.
+    else if (is_uart_dma_rx_active)
+    {
+        is_uart_dma_rx_active = false;
+        uart_dma_stats.idle_events++;
+
+        if (uart_dma_idle_callback != NULL)
+        {
+            uart_dma_idle_callback(uart_dma_available());
+        }
+    }
+
+    return true;
+}
+
+int uart_dma_init(uint8_t uart_number, uint8_t tx_pin, uint8_t rx_pin, uint32_t baud)
+{
+    // TX is on GPIO 4n and RX on 4n + 1. The UART alternates every 8 pins, starting with
+    // UART0 on GPIO 0 to 3 and UART1 on GPIO 4 to 11.
+    if (uart_number > 1 || tx_pin >= NUM_BANK0_GPIOS || rx_pin >= NUM_BANK0_GPIOS ||
+        (tx_pin & 3) != 0 || (rx_pin & 3) != 1 ||
+        (((tx_pin + 4) >> 3) & 1) != uart_number || (((rx_pin + 4) >> 3) & 1) != uart_number)
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    // 16 clk_peri cycles per bit at most, 7.8 Mbaud at the default 125 MHz.
+    if (baud == 0 || baud > clock_get_hz(clk_peri) / 16)
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    if (uart_dma_uart != NULL)
+    {
+        return PICO_ERROR_NOT_PERMITTED;
+    }
+
+    uart_dma_uart = UART_INSTANCE(uart_number);
+    uart_dma_stats = (uart_dma_stats_t) {0};
+    uart_dma_stats.baud = uart_init(uart_dma_uart, baud);
+    uart_set_fifo_enabled(uart_dma_uart, true);
+    gpio_set_function(tx_pin, GPIO_FUNC_UART);
+    gpio_set_function(rx_pin, GPIO_FUNC_UART);
+
+    uart_dma_tx_channel = dma_claim_unused_channel(true);
+    uart_dma_rx_channel = dma_claim_unused_channel(true);
+
+    dma_channel_config cfg = dma_channel_get_default_config(uart_dma_tx_channel);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, UART_DREQ_NUM(uart_dma_uart, true));
+    dma_channel_configure(uart_dma_tx_channel, &cfg, &uart_get_hw(uart_dma_uart)->dr, uart_dma_tx_ring, 0, false);
+    dma_channel_set_irq1_enabled(uart_dma_tx_channel, true);
+
+    irq_add_shared_handler(DMA_IRQ_1, uart_dma_tx_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    // The RX ring wraps in hardware, so the channel never needs the CPU.
+    cfg = dma_channel_get_default_config(uart_dma_rx_channel);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_ring(&cfg, true, UART_DMA_RX_BITS);
+    channel_config_set_dreq(&cfg, UART_DREQ_NUM(uart_dma_uart, false));
+    dma_channel_configure(uart_dma_rx_channel, &cfg, uart_dma_rx_ring, &uart_get_hw(uart_dma_uart)->dr, UINT32_MAX, true);
+
+    int64_t idle_us = 32 * 1000000ll / uart_dma_stats.baud;
+
+    if (idle_us < UART_DMA_IDLE_MIN_US)
+    {
+        idle_us = UART_DMA_IDLE_MIN_US;
+    }
+
+    if (!add_repeating_timer_us(-idle_us, uart_dma_idle_timer_callback, NULL, &uart_dma_idle_timer))
+    {
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+
+    return PICO_OK;
+}
+
+size_t uart_dma_write(const void * data, size_t length)
+{
+    if (uart_dma_uart == NULL)
+    {
+        return 0;
+    }
+
+    // Only what fits, the caller sees how much was queued.
+    uint32_t free = UART_DMA_TX_SIZE - (uart_dma_tx_head - uart_dma_tx_tail);
+
+    if (length > free)
+    {
+        length = free;
+    }
+
+    uint32_t index = uart_dma_tx_head % UART_DMA_TX_SIZE;
+    uint32_t first = length < UART_DMA_TX_SIZE - index ? length : UART_DMA_TX_SIZE - index;
+    memcpy(uart_dma_tx_ring + index, data, first);
+    memcpy(uart_dma_tx_ring, (const uint8_t *) data + first, length - first);
+
+    uint32_t save = save_and_disable_interrupts();
+    uart_dma_tx_head += length;
+    uart_dma_tx_start();
+    restore_interrupts(save);
+
+    return length;
+}
+
+size_t uart_dma_available()
+{
+    if (uart_dma_uart == NULL)
+    {
+        return 0;
+    }
+
+    uint32_t count = uart_dma_rx_head() - uart_dma_rx_tail;
+    return count < UART_DMA_RX_SIZE ? count : UART_DMA_RX_SIZE;
+}
+
+size_t uart_dma_read(void * data, size_t length)
+{
+    if (uart_dma_uart == NULL)
+    {
+        return 0;
+    }
+
+    uint32_t head = uart_dma_rx_head();
+    uint32_t count = head - uart_dma_rx_tail;
+
+    // The DMA has lapped the reader, only the last ring's worth is still there.
+    if (count > UART_DMA_RX_SIZE)
+    {
+        uart_dma_stats.rx_overruns += count - UART_DMA_RX_SIZE;
+        uart_dma_rx_tail = head - UART_DMA_RX_SIZE;
+        count = UART_DMA_RX_SIZE;
+    }
+
+    if (length > count)
+    {
+        length = count;
+    }
+
+    uint32_t index = uart_dma_rx_tail % UART_DMA_RX_SIZE;
+    uint32_t first = length < UART_DMA_RX_SIZE - index ? length : UART_DMA_RX_SIZE - index;
+    memcpy(data, uart_dma_rx_ring + index, first);
+    memcpy((uint8_t *) data + first, uart_dma_rx_ring, length - first);
+
+    uart_dma_rx_tail += length;
+    return length;
+}
+
+void uart_dma_set_idle_callback(void (*idle_callback)(size_t available))
+{
+    uart_dma_idle_callback = idle_callback;
+}
+
+void uart_dma_get_stats(uart_dma_stats_t * stats)
+{
+    *stats = uart_dma_stats;
+
+    if (uart_dma_uart != NULL)
+    {
+        stats->rx_bytes = uart_dma_rx_head();
+    }
+}
+
+#pragma endregion
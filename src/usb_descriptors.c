@@ -0,0 +1,125 @@
+#include "PicoLibrary.h"
+#include "pico/unique_id.h"
+#include "tusb.h"
+
+#pragma region USB Descriptors
+
+// Linking TinyUSB directly turns off the SDK's stdio descriptors, so these describe the
+// CDC interface stdio keeps using plus the stream interface. The IDs are in src/usb_stream.h.
+
+enum
+{
+    USB_INTERFACE_CDC,
+    USB_INTERFACE_CDC_DATA,
+    USB_INTERFACE_STREAM,
+    USB_INTERFACE_COUNT
+};
+
+_Static_assert(USB_INTERFACE_STREAM == USB_STREAM_INTERFACE, "USB_STREAM_INTERFACE must follow the CDC interfaces");
+
+#define USB_ENDPOINT_CDC_NOTIFY 0x81
+#define USB_ENDPOINT_CDC_OUT 0x02
+#define USB_ENDPOINT_CDC_IN 0x82
+#define USB_STREAM_DESCRIPTOR_LENGTH (9 + 7)
+#define USB_CONFIGURATION_LENGTH (TUD_CONFIG_DESC_LEN + TUD_CDC_DESC_LEN + USB_STREAM_DESCRIPTOR_LENGTH)
+
+enum
+{
+    USB_STRING_LANGUAGE,
+    USB_STRING_MANUFACTURER,
+    USB_STRING_PRODUCT,
+    USB_STRING_SERIAL,
+    USB_STRING_CDC,
+    USB_STRING_STREAM,
+    USB_STRING_COUNT
+};
+
+static const tusb_desc_device_t usb_device_descriptor =
+{
+    .bLength = sizeof(tusb_desc_device_t),
+    .bDescriptorType = TUSB_DESC_DEVICE,
+    .bcdUSB = 0x0200,
+
+    // Interface association descriptors, needed for the CDC pair in a composite device.
+    .bDeviceClass = TUSB_CLASS_MISC,
+    .bDeviceSubClass = MISC_SUBCLASS_COMMON,
+    .bDeviceProtocol = MISC_PROTOCOL_IAD,
+    .bMaxPacketSize0 = CFG_TUD_ENDPOINT0_SIZE,
+
+    .idVendor = USB_STREAM_VID,
+    .idProduct = USB_STREAM_PID,
+    .bcdDevice = 0x0101,
+
+    .iManufacturer = USB_STRING_MANUFACTURER,
+    .iProduct = USB_STRING_PRODUCT,
+    .iSerialNumber = USB_STRING_SERIAL,
+    .bNumConfigurations = 1
+};
+
+static const uint8_t usb_configuration_descriptor[USB_CONFIGURATION_LENGTH] =
+{
+    TUD_CONFIG_DESCRIPTOR(1, USB_INTERFACE_COUNT, 0, USB_CONFIGURATION_LENGTH, 0, 250),
+    TUD_CDC_DESCRIPTOR(USB_INTERFACE_CDC, USB_STRING_CDC, USB_ENDPOINT_CDC_NOTIFY, 8, USB_ENDPOINT_CDC_OUT, USB_ENDPOINT_CDC_IN, 64),
+
+    // Vendor interface with a single bulk IN endpoint
+    9, TUSB_DESC_INTERFACE, USB_INTERFACE_STREAM, 0, 1, TUSB_CLASS_VENDOR_SPECIFIC, 0, 0, USB_STRING_STREAM,
+    7, TUSB_DESC_ENDPOINT, USB_STREAM_ENDPOINT, TUSB_XFER_BULK, U16_TO_U8S_LE(USB_STREAM_PACKET_SIZE), 0
+};
+
+static const string usb_strings[USB_STRING_COUNT] =
+{
+    [USB_STRING_MANUFACTURER] = "Raspberry Pi",
+    [USB_STRING_PRODUCT] = "PicoLibrary Stream",
+    [USB_STRING_CDC] = "Board CDC",
+    [USB_STRING_STREAM] = "ADC Stream"
+};
+
+uint8_t const * tud_descriptor_device_cb()
+{
+    return (uint8_t const *) &usb_device_descriptor;
+}
+
+uint8_t const * tud_descriptor_configuration_cb(uint8_t index)
+{
+    return usb_configuration_descriptor;
+}
+
+uint16_t const * tud_descriptor_string_cb(uint8_t index, uint16_t language)
+{
+    static uint16_t descriptor[32];
+    static char serial[2 * PICO_UNIQUE_BOARD_ID_SIZE_BYTES + 1];
+    uint8_t length;
+
+    if (index == USB_STRING_LANGUAGE)
+    {
+        descriptor[1] = 0x0409; // English
+        length = 1;
+    }
+
+    else if (index < USB_STRING_COUNT)
+    {
+        const char * text = usb_strings[index];
+
+        if (index == USB_STRING_SERIAL)
+        {
+            pico_get_unique_board_id_string(serial, sizeof(serial));
+            text = serial;
+        }
+
+        // UTF-16, the strings are all ASCII.
+        for (length = 0; text[length] != '\0' && length < 31; length++)
+        {
+            descriptor[1 + length] = text[length];
+        }
+    }
+
+    else
+    {
+        return NULL;
+    }
+
+    descriptor[0] = (TUSB_DESC_STRING << 8) | (2 * length + 2);
+    return descriptor;
+}
+
+#pragma endregion
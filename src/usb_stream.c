@@ -0,0 +1,468 @@
+#include "PicoLibrary.h"
+#include "tusb.h"
+#include "device/usbd_pvt.h"
+
+#pragma region USB Stream Functions
+
+_Static_assert(USB_STREAM_BLOCK_SIZE <= SAMPLE_POOL_BLOCK_SIZE, "A stream block must fit in a sample pool block");
+
+uint8_t * usb_stream_blocks[USB_STREAM_BLOCKS]; // From the sample pool while the stream holds them
+int usb_stream_dma_channels[2] = {-1, -1};
+volatile uint8_t usb_stream_filling[2];
+volatile uint32_t usb_stream_busy_mask = 0; // Blocks being filled, queued or sent
+
+// Full blocks in the order they were filled.
+volatile uint8_t usb_stream_queue[USB_STREAM_BLOCKS];
+volatile uint8_t usb_stream_queue_head = 0;
+volatile uint8_t usb_stream_queue_tail = 0;
+
+volatile uint8_t usb_stream_rhport = 0;
+volatile uint8_t usb_stream_endpoint = 0; // Non-zero once the host has configured the interface
+volatile bool is_usb_stream_sending = false;
+volatile uint32_t usb_stream_sequence = 0;
+uint32_t usb_stream_sample_count;
+enum usb_stream_format_enum usb_stream_format;
+uint16_t usb_stream_block_lengths[USB_STREAM_BLOCKS]; // Bytes to send from each queued block
+volatile usb_stream_stats_t usb_stream_stats;
+uint64_t usb_stream_start_time;
+
+// Full packed or compressed blocks waiting for core1 to encode them, in the order they
+// were filled. Only the DMA interrupt adds to it and only core1 takes from it.
+volatile uint8_t usb_stream_encode_queue[USB_STREAM_BLOCKS];
+volatile uint8_t usb_stream_encode_head = 0;
+volatile uint8_t usb_stream_encode_tail = 0;
+
+// Guards the queue, the busy mask and the stats, which the TinyUSB task, the DMA
+// interrupt and the encoder on core1 share.
+spin_lock_t * usb_stream_lock = NULL;
+
+// Claimed on first use and kept. TinyUSB's driver init and usb_stream_start both come
+// before anything that can take the lock from an interrupt.
+static spin_lock_t * usb_stream_get_lock()
+{
+    if (usb_stream_lock == NULL)
+    {
+        usb_stream_lock = spin_lock_init(spin_lock_claim_unused(true));
+    }
+
+    return usb_stream_lock;
+}
+
+// Returns the blocks to the sample pool once the stream has stopped, all but one the host
+// is still reading, which goes when its transfer ends.
+static void usb_stream_release_blocks()
+{
+    for (int i = 0; i < USB_STREAM_BLOCKS; i++)
+    {
+        if (usb_stream_blocks[i] != NULL && !(usb_stream_busy_mask & (1u << i)))
+        {
+            block_pool_release(sample_pool_get(), usb_stream_blocks[i]);
+            usb_stream_blocks[i] = NULL;
+        }
+    }
+}
+
+static void usb_stream_send_next(void * param)
+{
+    // Marked as sending before the transfer starts, so usb_stream_stop keeps the block.
+    uint32_t save = spin_lock_blocking(usb_stream_lock);
+    bool is_ready = !is_usb_stream_sending && usb_stream_endpoint != 0 && usb_stream_queue_tail != usb_stream_queue_head;
+    uint8_t block = usb_stream_queue[usb_stream_queue_tail % USB_STREAM_BLOCKS];
+    is_usb_stream_sending = is_usb_stream_sending || is_ready;
+    spin_unlock(usb_stream_lock, save);
+
+    if (is_ready && !usbd_edpt_xfer(usb_stream_rhport, usb_stream_endpoint, usb_stream_blocks[block], usb_stream_block_lengths[block]))
+    {
+        is_usb_stream_sending = false;
+    }
+}
+
+// Queues a full block for sending, from the DMA interrupt or core1.
+static void PICO_LIBRARY_HOT(usb_stream_queue_block)(uint8_t block, bool is_in_isr)
+{
+    usb_stream_header_t * header = (usb_stream_header_t *) usb_stream_blocks[block];
+
+    uint32_t save = spin_lock_blocking(usb_stream_lock);
+    header->dropped_blocks = usb_stream_stats.dropped_blocks;
+    usb_stream_queue[usb_stream_queue_head % USB_STREAM_BLOCKS] = block;
+    usb_stream_queue_head++;
+    spin_unlock(usb_stream_lock, save);
+
+    usbd_defer_func(usb_stream_send_next, NULL, is_in_isr);
+}
+
+static void PICO_LIBRARY_HOT(usb_stream_encode_block)(uint8_t block)
+{
+    uint16_t * samples = (uint16_t *) (usb_stream_blocks[block] + sizeof(usb_stream_header_t));
+    uint16_t length;
+
+    if (usb_stream_format == USB_STREAM_PACKED_12_BIT)
+    {
+        length = sizeof(usb_stream_header_t) + pack12_block(samples, samples, usb_stream_sample_count);
+    }
+
+    else
+    {
+        length = sizeof(usb_stream_header_t) + rice_encode_block(samples, usb_stream_sample_count, USB_STREAM_RICE_ORDER, samples);
+
+        // A transfer that ends on a full packet looks unfinished to the host, which
+        // would run it into the next block. A padding byte ends it short instead.
+        if (length % USB_STREAM_PACKET_SIZE == 0)
+        {
+            usb_stream_blocks[block][length++] = 0;
+        }
+    }
+
+    usb_stream_block_lengths[block] = length;
+}
+
+// Packed and compressed blocks are encoded here, so the shared DMA_IRQ_1 handler only
+// hands them over.
+static void usb_stream_core1_entry()
+{
+    // Lets flash_log park this core while flash is erased or programmed.
+    flash_safe_execute_core_init();
+
+    while (true)
+    {
+        while (usb_stream_encode_tail == usb_stream_encode_head)
+        {
+            __wfe();
+        }
+
+        __dmb();
+        uint8_t block = usb_stream_encode_queue[usb_stream_encode_tail % USB_STREAM_BLOCKS];
+
+        // Taken off only once queued, so usb_stream_stop counts a block lost mid-encode.
+        usb_stream_encode_block(block);
+        usb_stream_queue_block(block, false);
+        usb_stream_encode_tail++;
+    }
+}
+
+static void PICO_LIBRARY_HOT(usb_stream_dma_handler)()
+{
+    for (int i = 0; i < 2; i++)
+    {
+        uint channel = usb_stream_dma_channels[i];
+
+        if (!dma_channel_get_irq1_status(channel))
+        {
+            continue;
+        }
+
+        dma_channel_acknowledge_irq1(channel);
+
+        // The other channel is filling its block now, find this one a free block for
+        // when it is chained back to. Without one, or without a host, the block is refilled.
+        uint8_t block = usb_stream_filling[i];
+        uint8_t next = block;
+        uint32_t save = spin_lock_blocking(usb_stream_lock);
+
+        if (usb_stream_endpoint != 0)
+        {
+            for (uint8_t candidate = 0; candidate < USB_STREAM_BLOCKS; candidate++)
+            {
+                if (!(usb_stream_busy_mask & (1u << candidate)))
+                {
+                    next = candidate;
+                    usb_stream_busy_mask |= 1u << next;
+                    break;
+                }
+            }
+        }
+
+        if (next == block)
+        {
+            usb_stream_stats.dropped_blocks++;
+        }
+
+        spin_unlock(usb_stream_lock, save);
+
+        if (next != block)
+        {
+            usb_stream_header_t * header = (usb_stream_header_t *) usb_stream_blocks[block];
+            header->sequence = usb_stream_sequence++;
+
+            if (usb_stream_format == USB_STREAM_16_BIT || usb_stream_format == USB_STREAM_8_BIT)
+            {
+                usb_stream_block_lengths[block] = USB_STREAM_BLOCK_SIZE;
+                usb_stream_queue_block(block, true);
+            }
+
+            else
+            {
+                // The block stays busy, so its slot here is free again before it is reused.
+                usb_stream_encode_queue[usb_stream_encode_head % USB_STREAM_BLOCKS] = block;
+                __dmb();
+                usb_stream_encode_head++;
+                __sev();
+            }
+        }
+
+        usb_stream_filling[i] = next;
+        dma_channel_set_write_addr(channel, usb_stream_blocks[next] + sizeof(usb_stream_header_t), false);
+    }
+}
+
+// TinyUSB class driver for the stream interface, TinyUSB runs these in its task.
+
+static void usb_stream_driver_init()
+{
+    usb_stream_get_lock();
+}
+
+static void usb_stream_driver_reset(uint8_t rhport)
+{
+    uint32_t save = spin_lock_blocking(usb_stream_lock);
+
+    // Anything still queued is lost with the host.
+    while (usb_stream_queue_tail != usb_stream_queue_head)
+    {
+        usb_stream_busy_mask &= ~(1u << usb_stream_queue[usb_stream_queue_tail % USB_STREAM_BLOCKS]);
+        usb_stream_queue_tail++;
+        usb_stream_stats.dropped_blocks++;
+    }
+
+    usb_stream_endpoint = 0;
+    is_usb_stream_sending = false;
+
+    if (usb_stream_dma_channels[0] < 0)
+    {
+        usb_stream_release_blocks();
+    }
+
+    spin_unlock(usb_stream_lock, save);
+}
+
+static uint16_t usb_stream_driver_open(uint8_t rhport, tusb_desc_interface_t const * interface, uint16_t max_length)
+{
+    if (interface->bInterfaceClass != TUSB_CLASS_VENDOR_SPECIFIC || interface->bInterfaceNumber != USB_STREAM_INTERFACE)
+    {
+        return 0;
+    }
+
+    uint16_t length = sizeof(tusb_desc_interface_t) + sizeof(tusb_desc_endpoint_t);
+    tusb_desc_endpoint_t const * endpoint = (tusb_desc_endpoint_t const *) tu_desc_next(interface);
+
+    if (max_length < length || !usbd_edpt_open(rhport, endpoint))
+    {
+        return 0;
+    }
+
+    usb_stream_rhport = rhport;
+    usb_stream_endpoint = endpoint->bEndpointAddress;
+    return length;
+}
+
+static bool usb_stream_driver_control_xfer(uint8_t rhport, uint8_t stage, tusb_control_request_t const * request)
+{
+    // No vendor requests, the stream is started and stopped on the device.
+    return false;
+}
+
+static bool usb_stream_driver_xfer(uint8_t rhport, uint8_t endpoint, xfer_result_t result, uint32_t transferred)
+{
+    if (endpoint != usb_stream_endpoint)
+    {
+        return false;
+    }
+
+    // The DMA interrupt updates the same state.
+    uint32_t save = spin_lock_blocking(usb_stream_lock);
+    usb_stream_busy_mask &= ~(1u << usb_stream_queue[usb_stream_queue_tail % USB_STREAM_BLOCKS]);
+    usb_stream_queue_tail++;
+    is_usb_stream_sending = false;
+
+    if (result == XFER_RESULT_SUCCESS)
+    {
+        usb_stream_stats.bytes_sent += transferred;
+        usb_stream_stats.blocks_sent++;
+    }
+
+    else
+    {
+        usb_stream_stats.dropped_blocks++;
+    }
+
+    if (usb_stream_dma_channels[0] < 0)
+    {
+        usb_stream_release_blocks();
+    }
+
+    spin_unlock(usb_stream_lock, save);
+
+    usb_stream_send_next(NULL);
+    return true;
+}
+
+static const usbd_class_driver_t usb_stream_driver =
+{
+    .init = usb_stream_driver_init,
+    .reset = usb_stream_driver_reset,
+    .open = usb_stream_driver_open,
+    .control_xfer_cb = usb_stream_driver_control_xfer,
+    .xfer_cb = usb_stream_driver_xfer,
+    .sof = NULL
+};
+
+// TinyUSB asks the application for extra class drivers.
+usbd_class_driver_t const * usbd_app_driver_get_cb(uint8_t * driver_count)
+{
+    *driver_count = 1;
+    return &usb_stream_driver;
+}
+
+int usb_stream_start(uint8_t adc_input, uint32_t sample_rate, enum usb_stream_format_enum format)
+{
+    // The ADC takes 96 cycles of its 48 MHz clock per conversion, 500 ksps at most.
+    if (sample_rate == 0 || sample_rate > 500000 || adc_input > 4 || format > USB_STREAM_RICE || usb_stream_dma_channels[0] >= 0)
+    {
+        return PICO_ERROR_INVALID_ARG;
+    }
+
+    block_pool_t * pool = sample_pool_get();
+
+    if (pool == NULL)
+    {
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+
+    // A block from the last run may still be going out, it is kept and the others are
+    // taken again.
+    uint32_t save = spin_lock_blocking(usb_stream_get_lock());
+    bool is_allocated = true;
+
+    for (int i = 0; i < USB_STREAM_BLOCKS && is_allocated; i++)
+    {
+        if (usb_stream_blocks[i] == NULL)
+        {
+            usb_stream_blocks[i] = block_pool_alloc(pool);
+            is_allocated = usb_stream_blocks[i] != NULL;
+        }
+    }
+
+    if (!is_allocated)
+    {
+        usb_stream_release_blocks();
+        spin_unlock(usb_stream_lock, save);
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+
+    // The channels start on the first two blocks not being sent.
+    int filling = 0;
+
+    for (uint8_t block = 0; block < USB_STREAM_BLOCKS && filling < 2; block++)
+    {
+        if (!(usb_stream_busy_mask & (1u << block)))
+        {
+            usb_stream_filling[filling++] = block;
+        }
+    }
+
+    usb_stream_busy_mask |= (1u << usb_stream_filling[0]) | (1u << usb_stream_filling[1]);
+    spin_unlock(usb_stream_lock, save);
+
+    bool is_8_bit = format == USB_STREAM_8_BIT;
+
+    adc_input_init(adc_input);
+    adc_select_input(adc_input);
+    adc_set_clkdiv(48000000.0f / sample_rate - 1);
+    adc_fifo_setup(true, true, 1, false, is_8_bit);
+
+    usb_stream_stats = (usb_stream_stats_t) {0};
+    usb_stream_stats.sample_rate = sample_rate;
+    usb_stream_sequence = 0;
+    usb_stream_start_time = time_us_64();
+
+    // Packed and compressed blocks are filled as 16-bit samples, so they hold as many, sent
+    // in fewer bytes.
+    uint32_t sample_count = (USB_STREAM_BLOCK_SIZE - sizeof(usb_stream_header_t)) / (is_8_bit ? 1 : 2);
+    usb_stream_format = format;
+    usb_stream_sample_count = sample_count;
+
+    if (format == USB_STREAM_PACKED_12_BIT || format == USB_STREAM_RICE)
+    {
+        usb_stream_encode_head = 0;
+        usb_stream_encode_tail = 0;
+        multicore_launch_core1(usb_stream_core1_entry);
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        usb_stream_dma_channels[i] = dma_claim_unused_channel(true);
+    }
+
+    // Each channel writes after the header of its block.
+    void * buffers[2];
+
+    for (int i = 0; i < 2; i++)
+    {
+        buffers[i] = usb_stream_blocks[usb_stream_filling[i]] + sizeof(usb_stream_header_t);
+    }
+
+    dma_ping_pong_configure(usb_stream_dma_channels, is_8_bit ? DMA_SIZE_8 : DMA_SIZE_16, DREQ_ADC, &adc_hw->fifo, buffers, sample_count, false, 1);
+
+    irq_add_shared_handler(DMA_IRQ_1, usb_stream_dma_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    dma_channel_start(usb_stream_dma_channels[0]);
+    adc_run(true);
+    return PICO_OK;
+}
+
+void usb_stream_stop()
+{
+    if (usb_stream_dma_channels[0] < 0)
+    {
+        return;
+    }
+
+    adc_run(false);
+    dma_ping_pong_stop(usb_stream_dma_channels, 1);
+
+    irq_remove_handler(DMA_IRQ_1, usb_stream_dma_handler);
+    adc_fifo_drain();
+
+    if (usb_stream_format == USB_STREAM_PACKED_12_BIT || usb_stream_format == USB_STREAM_RICE)
+    {
+        multicore_reset_core1();
+
+        // Core1 may have been reset holding the lock.
+        spin_unlock_unsafe(usb_stream_lock);
+    }
+
+    // Blocks still queued are dropped, only one already being sent finishes. So are any
+    // core1 had not encoded, the busy mask below frees them.
+    uint32_t save = spin_lock_blocking(usb_stream_lock);
+    usb_stream_stats.dropped_blocks += (uint8_t) (usb_stream_encode_head - usb_stream_encode_tail);
+    usb_stream_encode_head = usb_stream_encode_tail;
+    uint8_t kept = is_usb_stream_sending ? 1 : 0;
+
+    while ((uint8_t) (usb_stream_queue_head - usb_stream_queue_tail) > kept)
+    {
+        usb_stream_queue_head--;
+        usb_stream_stats.dropped_blocks++;
+    }
+
+    usb_stream_busy_mask = kept ? 1u << usb_stream_queue[usb_stream_queue_tail % USB_STREAM_BLOCKS] : 0;
+    usb_stream_release_blocks();
+    spin_unlock(usb_stream_lock, save);
+}
+
+bool usb_stream_is_connected()
+{
+    return usb_stream_endpoint != 0;
+}
+
+void usb_stream_get_stats(usb_stream_stats_t * stats)
+{
+    uint32_t save = spin_lock_blocking(usb_stream_get_lock());
+    *stats = usb_stream_stats;
+    spin_unlock(usb_stream_lock, save);
+
+    uint64_t elapsed = time_us_64() - usb_stream_start_time;
+    stats->bytes_per_second = elapsed > 0 ? stats->bytes_sent * 1000000.0f / elapsed : 0.0f;
+}
+
+#pragma endregion
@@ -0,0 +1,40 @@
+#ifndef PICO_LIBRARY_USB_STREAM_H_
+#define PICO_LIBRARY_USB_STREAM_H_
+
+#include "portable.h"
+
+// USB stream functions
+// What the host sees of the stream: the device's IDs, the vendor interface and its bulk IN
+// endpoint, and the blocks. Each transfer is one block of at most USB_STREAM_BLOCK_SIZE
+// bytes, a usb_stream_header_t followed by samples in the stream's format. The sequence
+// counts the blocks queued since usb_stream_start, and dropped_blocks counts those the
+// Pico had to drop because the host fell behind. Blocks shorter than USB_STREAM_BLOCK_SIZE
+// never end on a whole packet, so a host read of USB_STREAM_BLOCK_SIZE bytes always returns
+// exactly one block. Compressed blocks that would are sent with a zero byte after them.
+// host/usb_stream_receive.c is the reader.
+#ifndef USB_STREAM_VID
+    #define USB_STREAM_VID 0x2e8a // Raspberry Pi
+#endif
+#ifndef USB_STREAM_PID
+    #define USB_STREAM_PID 0x000a // Same as the SDK's stdio
+#endif
+#define USB_STREAM_PACKET_SIZE 64
+#define USB_STREAM_BLOCK_SIZE 4096 // Multiple of USB_STREAM_PACKET_SIZE
+#define USB_STREAM_INTERFACE 2
+#define USB_STREAM_ENDPOINT 0x83
+
+enum usb_stream_format_enum
+{
+    USB_STREAM_16_BIT,
+    USB_STREAM_8_BIT,
+    USB_STREAM_PACKED_12_BIT,   // See pack12_block
+    USB_STREAM_RICE             // See rice_encode_block
+};
+
+typedef struct
+{
+    uint32_t sequence;
+    uint32_t dropped_blocks;
+} usb_stream_header_t;
+
+#endif
@@ -0,0 +1,71 @@
+#include "PicoLibrary.h"
+
+#pragma region Utility Functions
+
+bool contains_uint8_t(uint8_t array[], uint8_t value)
+{
+    for (uint8_t i = 0; i < temp_adc_gpio_index; i++)
+    {
+        if (value == array[i])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void dma_channel_unchain(uint channel)
+{
+    // Chaining a channel to itself is how the hardware says no chain.
+    hw_clear_bits(&dma_hw->ch[channel].al1_ctrl, DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS);
+    hw_set_bits(&dma_hw->ch[channel].al1_ctrl, channel << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB);
+}
+
+void dma_ping_pong_configure(const int channels[2], enum dma_channel_transfer_size size, uint dreq, volatile void * peripheral, void * const buffers[2], uint count, bool is_to_peripheral, int irq_index)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        dma_channel_config cfg = dma_channel_get_default_config(channels[i]);
+        channel_config_set_transfer_data_size(&cfg, size);
+        channel_config_set_read_increment(&cfg, is_to_peripheral);
+        channel_config_set_write_increment(&cfg, !is_to_peripheral);
+        channel_config_set_dreq(&cfg, dreq);
+        channel_config_set_chain_to(&cfg, channels[i ^ 1]);
+
+        if (is_to_peripheral)
+        {
+            dma_channel_configure(channels[i], &cfg, peripheral, buffers[i], count, false);
+        }
+
+        else
+        {
+            dma_channel_configure(channels[i], &cfg, buffers[i], peripheral, count, false);
+        }
+
+        if (irq_index >= 0)
+        {
+            dma_irqn_set_channel_enabled(irq_index, channels[i], true);
+        }
+    }
+}
+
+void dma_ping_pong_stop(int channels[2], uint irq_index)
+{
+    // Unchain first so aborting one channel does not start the other.
+    for (int i = 0; i < 2; i++)
+    {
+        dma_irqn_set_channel_enabled(irq_index, channels[i], false);
+        dma_channel_unchain(channels[i]);
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        dma_channel_abort(channels[i]);
+        dma_irqn_acknowledge_channel(irq_index, channels[i]);
+        dma_channel_unclaim(channels[i]);
+        channels[i] = -1;
+    }
+}
+
+#pragma endregion
@@ -0,0 +1,19 @@
+#ifndef TUSB_CONFIG_H_
+#define TUSB_CONFIG_H_
+
+// TinyUSB set-up for images that link pico_library_usb_stream: the CDC interface used by
+// stdio plus the vendor stream interface, whose class driver is in src/usb_stream.c.
+// CFG_TUSB_MCU and CFG_TUSB_OS come from the SDK.
+
+#define CFG_TUSB_RHPORT0_MODE OPT_MODE_DEVICE
+#define CFG_TUD_ENDPOINT0_SIZE 64
+
+#define CFG_TUD_CDC 1
+#define CFG_TUD_CDC_RX_BUFSIZE 256
+#define CFG_TUD_CDC_TX_BUFSIZE 256
+
+// The stream interface is vendor class, but handled by the application driver rather
+// than the TinyUSB vendor class and its FIFOs.
+#define CFG_TUD_VENDOR 0
+
+#endif